@@ -0,0 +1,155 @@
+// Compares reading task request bodies with jsoncpp, as api.cpp does (parse into a
+// Json::Value tree, then copy fields out), and with JsonReader, as api_docker.cpp does
+// (walk the text in place and assign straight into Task fields).
+// Usage: json_reader_benchmark [task count] [repetitions]
+#include "JsonReader.h"
+#include "JsonWriter.h"
+#include "Task.h"
+#include <json/json.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A {"tasks":[...]} batch body like the frontend sends
+static std::string makeBatchBody(std::size_t count) {
+    std::mt19937 rng(42);
+    std::string body;
+    JsonWriter json(body);
+    json.beginObject().key("tasks").beginArray();
+    for (std::size_t i = 0; i < count; ++i) {
+        json.beginObject()
+            .key("header").value("Task " + std::to_string(i + 1))
+            .key("description").value(rng() % 4 == 0 ? "Say \"hi\"\nthen leave" : "Plain description of the work to do")
+            .key("difficulty").value(static_cast<int>(rng() % 5) + 1)
+            .key("dueDate").value(rng() % 10 == 0 ? "" : "2024-06-15")
+            .endObject();
+    }
+    json.endArray().endObject();
+    return body;
+}
+
+// --- jsoncpp, as in api.cpp ---
+
+static void taskFromJson(const Json::Value& json, Task& task) {
+    if (!json.isObject() || !json.isMember("header") || !json.isMember("difficulty")) {
+        throw std::runtime_error("Missing required fields");
+    }
+    task.difficulty = json["difficulty"].asInt();
+    task.header = json["header"].asString();
+    task.description = json.isMember("description") ? json["description"].asString() : "";
+    task.dueDate = json.isMember("dueDate") ? json["dueDate"].asString() : "";
+}
+
+static std::vector<Task> readWithJsoncpp(const std::string& body) {
+    Json::CharReaderBuilder builder;
+    std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+    Json::Value root;
+    std::string errors;
+    if (!reader->parse(body.data(), body.data() + body.size(), &root, &errors)) {
+        throw std::runtime_error(errors);
+    }
+    const Json::Value& items = root["tasks"];
+    std::vector<Task> tasks(items.size());
+    for (Json::ArrayIndex i = 0; i < items.size(); ++i) {
+        taskFromJson(items[i], tasks[i]);
+    }
+    return tasks;
+}
+
+// --- JsonReader, as in api_docker.cpp ---
+
+static std::vector<Task> readWithJsonReader(const std::string& body) {
+    std::vector<Task> tasks;
+    JsonReader json(body);
+    json.beginObject();
+    std::string_view key;
+    while (json.nextMember(key)) {
+        if (key != "tasks") {
+            json.skipValue();
+            continue;
+        }
+        json.beginArray();
+        while (json.nextElement()) {
+            if (!json.task(tasks.emplace_back())) {
+                throw std::runtime_error("Missing required fields");
+            }
+        }
+    }
+    json.end();
+    return tasks;
+}
+
+// Median wall time of `repetitions` runs of fn, in milliseconds
+template <typename Fn>
+static double medianMillis(int repetitions, Fn fn) {
+    std::vector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 10000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 21;
+    std::string batch = makeBatchBody(count);
+    std::string single = makeBatchBody(1);
+    single = single.substr(10, single.size() - 12);  // The lone {...} inside {"tasks":[...]}
+
+    // Both must read the same tasks
+    std::vector<Task> expected = readWithJsoncpp(batch);
+    std::vector<Task> actual = readWithJsonReader(batch);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        if (expected[i].header != actual[i].header || expected[i].description != actual[i].description ||
+            expected[i].difficulty != actual[i].difficulty || expected[i].dueDate != actual[i].dueDate) {
+            std::cerr << "Task " << i << " differs\n";
+            return 1;
+        }
+    }
+
+    std::size_t sink = 0;
+    double jsoncppMs = medianMillis(repetitions, [&] { sink += readWithJsoncpp(batch).size(); });
+    double readerMs = medianMillis(repetitions, [&] { sink += readWithJsonReader(batch).size(); });
+
+    // Single-task bodies (POST /api/tasks, PUT /api/tasks/{id}), many times over
+    constexpr int singleRuns = 10000;
+    double jsoncppSingleMs = medianMillis(repetitions, [&] {
+        Json::CharReaderBuilder builder;
+        std::unique_ptr<Json::CharReader> reader(builder.newCharReader());
+        Task task;
+        for (int i = 0; i < singleRuns; ++i) {
+            Json::Value root;
+            std::string errors;
+            reader->parse(single.data(), single.data() + single.size(), &root, &errors);
+            taskFromJson(root, task);
+            sink += task.header.size();
+        }
+    });
+    double readerSingleMs = medianMillis(repetitions, [&] {
+        Task task;
+        for (int i = 0; i < singleRuns; ++i) {
+            JsonReader json(single);
+            json.task(task);
+            json.end();
+            sink += task.header.size();
+        }
+    });
+
+    std::cout << count << " task batch (" << batch.size() << " bytes), median of " << repetitions << " runs (ms)\n"
+              << "  jsoncpp:    " << jsoncppMs << " (" << batch.size() / jsoncppMs / 1000 << " MB/s)\n"
+              << "  JsonReader: " << readerMs << " (" << batch.size() / readerMs / 1000 << " MB/s)\n"
+              << singleRuns << " single-task bodies (" << single.size() << " bytes each) (ms)\n"
+              << "  jsoncpp:    " << jsoncppSingleMs << "\n"
+              << "  JsonReader: " << readerSingleMs << "\n"
+              << "  (" << sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+// Compares building a {"tasks":[...]} HTTP response the way api_docker.cpp used to
+// (one ostringstream per task, another for the array, a third for the response)
+// with JsonWriter streaming body and head into one reserved buffer.
+// Usage: json_writer_benchmark [task count] [repetitions]
+#include "JsonWriter.h"
+#include "Task.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static std::vector<Task> makeTasks(std::size_t count) {
+    std::mt19937 rng(42);
+    std::vector<Task> tasks(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        tasks[i].id = static_cast<int>(i + 1);
+        tasks[i].header = "Task " + std::to_string(i + 1);
+        tasks[i].description = rng() % 4 == 0 ? "Say \"hi\"\nthen leave" : "Plain description of the work to do";
+        tasks[i].completed = rng() % 3 == 0;
+        tasks[i].difficulty = static_cast<int>(rng() % 5) + 1;
+        tasks[i].dueDate = rng() % 10 == 0 ? "" : "2024-06-15";
+    }
+    return tasks;
+}
+
+// --- The previous api_docker.cpp implementation ---
+
+static std::string escapeJsonString(const std::string& s) {
+    std::ostringstream o;
+    for (auto c = s.cbegin(); c != s.cend(); c++) {
+        if (*c == '"' || *c == '\\' || ('\x00' <= *c && *c <= '\x1f')) {
+            o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*c);
+        } else {
+            o << *c;
+        }
+    }
+    return o.str();
+}
+
+static std::string taskToJson(const Task& task) {
+    std::ostringstream ss;
+    ss << "{";
+    ss << "\"id\":" << task.id << ",";
+    ss << "\"header\":\"" << escapeJsonString(task.header) << "\",";
+    ss << "\"description\":\"" << escapeJsonString(task.description) << "\",";
+    ss << "\"completed\":" << (task.completed ? "true" : "false") << ",";
+    ss << "\"difficulty\":" << task.difficulty << ",";
+    ss << "\"dueDate\":\"" << escapeJsonString(task.dueDate) << "\"";
+    ss << "}";
+    return ss.str();
+}
+
+static std::string tasksToJson(const std::vector<Task>& tasks) {
+    std::ostringstream ss;
+    ss << "{\"tasks\":[";
+    for (size_t i = 0; i < tasks.size(); ++i) {
+        if (i > 0) {
+            ss << ",";
+        }
+        ss << taskToJson(tasks[i]);
+    }
+    ss << "]}";
+    return ss.str();
+}
+
+static std::string legacyResponse(const std::vector<Task>& tasks) {
+    std::string body = tasksToJson(tasks);
+    std::ostringstream response;
+    response << "HTTP/1.1 200 OK\r\n";
+    response << "Content-Type: application/json\r\n";
+    response << "Content-Length: " << body.length() << "\r\n";
+    response << "Access-Control-Allow-Origin: *\r\n";
+    response << "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n";
+    response << "Access-Control-Allow-Headers: Content-Type\r\n";
+    response << "\r\n";
+    response << body;
+    return response.str();
+}
+
+// --- Single buffer, as api_docker.cpp now does it ---
+
+static std::string writerResponse(const std::vector<Task>& tasks) {
+    constexpr std::size_t lengthWidth = 20;
+    std::size_t reserve = 256 + 48;
+    for (const auto& task : tasks) {
+        reserve += JsonWriter::estimateTaskSize(task);
+    }
+    std::string out;
+    out.reserve(reserve);
+    out += "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+           "Access-Control-Allow-Origin: *\r\n"
+           "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+           "Access-Control-Allow-Headers: Content-Type\r\n"
+           "Content-Length:";
+    out.append(lengthWidth, ' ');
+    out += "\r\n\r\n";
+    std::size_t bodyStart = out.size();
+
+    JsonWriter json(out);
+    json.beginObject().key("tasks").beginArray();
+    for (const auto& task : tasks) {
+        json.task(task);
+    }
+    json.endArray().endObject();
+
+    char digits[lengthWidth];
+    char* end = std::to_chars(digits, digits + sizeof(digits), out.size() - bodyStart).ptr;
+    std::size_t length = static_cast<std::size_t>(end - digits);
+    std::memcpy(&out[bodyStart - 4 - length], digits, length);
+    return out;
+}
+
+// Median wall time of `repetitions` runs of fn, in milliseconds
+template <typename Fn>
+static double medianMillis(int repetitions, Fn fn) {
+    std::vector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 10000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 21;
+    std::vector<Task> tasks = makeTasks(count);
+
+    // Same body either way; only the Content-Length padding differs
+    std::string legacy = legacyResponse(tasks);
+    std::string writer = writerResponse(tasks);
+    std::string legacyBody = legacy.substr(legacy.find("\r\n\r\n"));
+    std::string writerBody = writer.substr(writer.find("\r\n\r\n"));
+    if (legacyBody != writerBody) {
+        std::cerr << "Bodies differ\n";
+        return 1;
+    }
+
+    std::size_t sink = 0;
+    double legacyMs = medianMillis(repetitions, [&] { sink += legacyResponse(tasks).size(); });
+    double writerMs = medianMillis(repetitions, [&] { sink += writerResponse(tasks).size(); });
+    std::cout << count << " tasks (" << writerBody.size() << " byte body), median of " << repetitions << " runs (ms)\n"
+              << "  ostringstream: " << legacyMs << "\n"
+              << "  JsonWriter:    " << writerMs << "\n"
+              << "  (" << sink << " bytes built)\n";
+    return 0;
+}
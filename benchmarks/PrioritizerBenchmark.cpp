@@ -0,0 +1,104 @@
+// Compares TaskPrioritizer against a hand-written runtime-dispatch baseline
+// (one lambda per strategy, selected by a switch for every task).
+// Usage: prioritizer_benchmark [task count] [repetitions]
+#include "TaskPrioritizer.h"
+#include "DueDate.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using Strategy = TaskPrioritizer::Strategy;
+using SortKey = TaskPrioritizer::SortKey;
+
+static std::vector<Task> makeTasks(std::size_t count) {
+    std::mt19937 rng(42);
+    int today = currentEpochDay();
+    std::vector<Task> tasks(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        tasks[i].id = static_cast<int>(i + 1);
+        tasks[i].header = "Task " + std::to_string(i + 1);
+        tasks[i].difficulty = static_cast<int>(rng() % 5) + 1;
+        tasks[i].dueDay = rng() % 10 == 0 ? NO_DUE_DAY : today + static_cast<int>(rng() % 400) - 30;
+    }
+    return tasks;
+}
+
+// The same keys, computed through a std::function chosen at runtime
+static void baselinePrioritize(std::vector<Task>& tasks, Strategy strategy, TaskPrioritizer::Weights weights) {
+    int today = currentEpochDay();
+    std::function<SortKey(const Task&, std::uint32_t)> keyOf;
+    switch (strategy) {
+        case Strategy::DUE_DATE_FIRST:
+            keyOf = [](const Task& t, std::uint32_t i) -> SortKey { return {double(t.dueDay), -t.difficulty, i}; };
+            break;
+        case Strategy::DIFFICULTY_FIRST:
+            keyOf = [](const Task& t, std::uint32_t i) -> SortKey { return {double(t.difficulty), t.dueDay, i}; };
+            break;
+        case Strategy::WEIGHTED:
+            keyOf = [weights, today](const Task& t, std::uint32_t i) -> SortKey {
+                if (t.dueDay == NO_DUE_DAY) return {DBL_MAX, -t.difficulty, i};
+                return {weights.dueDate * std::max(0, t.dueDay - today) - weights.difficulty * t.difficulty, 0, i};
+            };
+            break;
+        case Strategy::BALANCED:
+        default:
+            keyOf = [today](const Task& t, std::uint32_t i) -> SortKey {
+                return {TaskPrioritizer::balancedScore(t.dueDay, t.difficulty, today), 0, i};
+            };
+            break;
+    }
+    
+    std::vector<SortKey> keys(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        keys[i] = keyOf(tasks[i], static_cast<std::uint32_t>(i));
+    }
+    std::sort(keys.begin(), keys.end());
+    std::vector<Task> ordered;
+    ordered.reserve(keys.size());
+    for (const auto& key : keys) {
+        ordered.push_back(std::move(tasks[key.index]));
+    }
+    tasks.swap(ordered);
+}
+
+// Median wall time of `repetitions` runs of fn on fresh copies of `input`, in milliseconds
+template <typename Fn>
+static double medianMillis(const std::vector<Task>& input, int repetitions, Fn fn) {
+    std::vector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        std::vector<Task> tasks = input;
+        auto start = std::chrono::steady_clock::now();
+        fn(tasks);
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 7;
+    std::vector<Task> input = makeTasks(count);
+    TaskPrioritizer::Weights weights = {2.0, 1.0};
+    
+    std::cout << count << " tasks, median of " << repetitions << " runs (ms)\n";
+    for (Strategy strategy : TaskPrioritizer::allStrategies()) {
+        TaskPrioritizer prioritizer(strategy);
+        prioritizer.setWeights(weights);
+        double baseline = medianMillis(input, repetitions, [&](std::vector<Task>& tasks) {
+            baselinePrioritize(tasks, strategy, weights);
+        });
+        double policy = medianMillis(input, repetitions, [&](std::vector<Task>& tasks) {
+            prioritizer.prioritizeTasks(tasks);
+        });
+        std::cout << "  " << TaskPrioritizer::strategyName(strategy)
+                  << ": baseline " << baseline << ", policy " << policy << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Compares the IN_MEMORY and SQL prioritization engines of ToDoList on a
+// temporary database. Usage: priority_engine_benchmark [task count] [repetitions]
+#include "ToDoList.h"
+#include "DueDate.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+static void fillDatabase(ToDoList& todoList, std::size_t count) {
+    std::mt19937 rng(42);
+    std::vector<Task> tasks(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        tasks[i].header = "Task " + std::to_string(i + 1);
+        tasks[i].difficulty = static_cast<int>(rng() % 5) + 1;
+        if (rng() % 10 != 0) {
+            int year = 2025 + static_cast<int>(rng() % 3);
+            int month = 1 + static_cast<int>(rng() % 12);
+            int day = 1 + static_cast<int>(rng() % 28);
+            char date[11];
+            std::snprintf(date, sizeof(date), "%04d-%02d-%02d", year, month, day);
+            tasks[i].dueDate = date;
+        }
+    }
+    todoList.addTasks(tasks);
+}
+
+// Median wall time of `repetitions` calls, in milliseconds
+template <typename Fn>
+static double medianMillis(int repetitions, Fn fn) {
+    std::vector<double> samples;
+    for (int r = 0; r < repetitions; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 100000;
+    int repetitions = argc > 2 ? std::stoi(argv[2]) : 7;
+    const std::string path = "priority_engine_benchmark.db";
+    std::filesystem::remove(path);
+    
+    {
+        ToDoList todoList;
+        todoList.connect(path);
+        fillDatabase(todoList, count);
+        
+        std::cout << count << " open tasks, median of " << repetitions << " runs (ms)\n";
+        for (auto strategy : TaskPrioritizer::allStrategies()) {
+            for (std::size_t limit : {std::size_t(10), std::size_t(0)}) {
+                todoList.setPriorityEngine(ToDoList::PriorityEngine::IN_MEMORY);
+                double firstLoad = medianMillis(1, [&] { todoList.getPrioritizedTasks(strategy, limit); });
+                double memory = medianMillis(repetitions, [&] { todoList.getPrioritizedTasks(strategy, limit); });
+                todoList.setPriorityEngine(ToDoList::PriorityEngine::SQL);
+                double sql = medianMillis(repetitions, [&] { todoList.getPrioritizedTasks(strategy, limit); });
+                
+                std::cout << "  " << TaskPrioritizer::strategyName(strategy)
+                          << " limit " << (limit == 0 ? std::string("all") : std::to_string(limit))
+                          << ": in-memory " << memory << " (first load " << firstLoad << "), sql " << sql << "\n";
+            }
+        }
+    }
+    
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + "-wal");
+    std::filesystem::remove(path + "-shm");
+    return 0;
+}
@@ -1,10 +1,44 @@
-CREATE TABLE tasks (
+-- Reference schema for data/tasks.db.
+-- The authoritative definition is the migration list in src/ToDoList.cpp,
+-- which ToDoList::connect applies on startup (tracked via PRAGMA user_version).
+-- Keep this file in sync with the latest migration.
+
+-- Migration 1
+CREATE TABLE IF NOT EXISTS tasks (
     id INTEGER PRIMARY KEY AUTOINCREMENT,
     header TEXT NOT NULL,
-    description TEXT NOT NULL,
-    completed BOOLEAN NOT NULL DEFAULT 0,
-    difficulty INTEGER NOT NULL CHECK (difficulty BETWEEN 1 AND 5),
-    created_at DATETIME DEFAULT CURRENT_TIMESTAMP
-    -- due_date TEXT,  // We can add this later
-    -- category TEXT,  // We can add this later
-);
\ No newline at end of file
+    description TEXT,
+    completed INTEGER DEFAULT 0,
+    difficulty INTEGER CHECK(difficulty BETWEEN 1 AND 5),
+    dueDate TEXT
+);
+
+-- Migration 2
+CREATE INDEX IF NOT EXISTS idx_tasks_completed ON tasks(completed);
+
+-- Migration 3: dueDate as days since 1970-01-01; 2147483647 when there is no due date
+ALTER TABLE tasks ADD COLUMN dueDay INTEGER;
+CREATE INDEX IF NOT EXISTS idx_tasks_completed_due_day ON tasks(completed, dueDay);
+
+-- Migration 4: indexes matching the SQL prioritization engine's ORDER BY clauses
+CREATE INDEX IF NOT EXISTS idx_tasks_completed_due_first ON tasks(completed, dueDay, difficulty DESC);
+CREATE INDEX IF NOT EXISTS idx_tasks_completed_difficulty ON tasks(completed, difficulty, dueDay);
+DROP INDEX IF EXISTS idx_tasks_completed_due_day;
+
+-- Migration 5: full-text index for searchTasks, kept in sync by triggers
+CREATE VIRTUAL TABLE IF NOT EXISTS tasks_fts USING fts5(
+    header, description, content='tasks', content_rowid='id',
+    tokenize='unicode61 remove_diacritics 2', prefix='2 3'
+);
+CREATE TRIGGER IF NOT EXISTS tasks_fts_insert AFTER INSERT ON tasks BEGIN
+    INSERT INTO tasks_fts(rowid, header, description) VALUES (new.id, new.header, new.description);
+END;
+CREATE TRIGGER IF NOT EXISTS tasks_fts_delete AFTER DELETE ON tasks BEGIN
+    INSERT INTO tasks_fts(tasks_fts, rowid, header, description) VALUES ('delete', old.id, old.header, old.description);
+END;
+CREATE TRIGGER IF NOT EXISTS tasks_fts_update AFTER UPDATE OF header, description ON tasks BEGIN
+    INSERT INTO tasks_fts(tasks_fts, rowid, header, description) VALUES ('delete', old.id, old.header, old.description);
+    INSERT INTO tasks_fts(rowid, header, description) VALUES (new.id, new.header, new.description);
+END;
+
+PRAGMA user_version = 5;
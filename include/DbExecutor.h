@@ -0,0 +1,58 @@
+#ifndef DB_EXECUTOR_H
+#define DB_EXECUTOR_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+
+// Runs blocking database work on dedicated threads so network event loops never
+// wait on SQLite. Reads and writes have separate bounded queues and worker pools:
+// a write stuck in fsync only delays the writes queued behind it, and reads keep
+// flowing on their own threads (ToDoList gives each reader its own connection).
+class DbExecutor {
+public:
+    enum class Lane { READ, WRITE };
+
+    static constexpr std::size_t DEFAULT_QUEUE_CAPACITY = 1024;
+
+    // readThreads 0 = one per core; writes are serialized by ToDoList anyway,
+    // so one write thread is usually enough
+    explicit DbExecutor(unsigned readThreads = 0, unsigned writeThreads = 1,
+                        std::size_t queueCapacity = DEFAULT_QUEUE_CAPACITY);
+    ~DbExecutor();  // Runs the jobs already queued, then joins the workers
+
+    DbExecutor(const DbExecutor&) = delete;
+    DbExecutor& operator=(const DbExecutor&) = delete;
+
+    // Queues a job. Returns false and drops the job when that lane's queue is full
+    // or the executor is shutting down, so the caller can shed load.
+    // Exceptions escaping a job are swallowed; jobs should report their own errors.
+    bool submit(Lane lane, std::function<void()> job);
+
+    // Stops accepting jobs, drains both queues and joins the workers. Idempotent.
+    void shutdown();
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::deque<std::function<void()>> jobs;
+        std::size_t capacity = 0;
+        bool stopping = false;
+        std::vector<std::thread> workers;
+    };
+
+    Queue reads;
+    Queue writes;
+
+    Queue& queueFor(Lane lane) { return lane == Lane::READ ? reads : writes; }
+    static void start(Queue& queue, unsigned threads, std::size_t capacity);
+    static void work(Queue& queue);
+    static void stop(Queue& queue);
+};
+
+#endif
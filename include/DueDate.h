@@ -0,0 +1,21 @@
+#ifndef DUE_DATE_H
+#define DUE_DATE_H
+
+#include <string_view>
+#include <limits>
+
+// Due dates travel through the API as YYYY-MM-DD strings, but are also kept as
+// epoch days (days since 1970-01-01) so they compare and index as plain integers.
+
+// Epoch day used for tasks without a (valid) due date; sorts after every real date
+constexpr int NO_DUE_DAY = std::numeric_limits<int>::max();
+
+// Parses YYYY-MM-DD without allocating or touching the locale/timezone database.
+// Day overflow within 1-31 rolls into the next month like mktime does (2023-02-30 -> March 2).
+// Returns NO_DUE_DAY for empty or malformed input.
+int epochDayFromDate(std::string_view date);
+
+// Today's epoch day in local time
+int currentEpochDay();
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef ETAG_H
+#define ETAG_H
+
+#include <string>
+#include <string_view>
+
+class ToDoList;
+
+// Conditional GETs for task data, shared by both servers. Responses built from
+// ToDoList data carry an ETag derived from its data version, so any committed
+// mutation changes the tag.
+
+// Quoted ETag from the data version tag; `variant` is for representations that also
+// depend on something else (the prioritized order depends on today's date). Take it
+// before the query, so it is never newer than the data.
+std::string dataETag(const ToDoList& todoList, const std::string& variant = "");
+
+// True when an If-None-Match header ("*" or a comma-separated list, weak tags
+// allowed) names `etag`
+bool etagMatches(std::string_view ifNoneMatch, std::string_view etag);
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef HEADER_SUGGESTER_H
+#define HEADER_SUGGESTER_H
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+// In-memory prefix index of task headers for type-ahead. Headers are normalized
+// (trimmed, ASCII-lowercased) and kept in sorted order with the number of tasks
+// using each, so a prefix is one ordered range and a lookup costs O(log n + range)
+// instead of a table scan. Updated per mutation by task id.
+// Not thread-safe; ToDoList guards it with its own mutex.
+class HeaderSuggester {
+public:
+    struct Suggestion {
+        std::string header;  // Spelling of the most recently added task
+        int count;           // Tasks (open or completed) with this header
+    };
+
+    static constexpr std::size_t maxLimit = 50;
+
+    bool isLoaded() const { return loaded; }
+    void load(const std::vector<std::pair<int, std::string>>& headers);  // Replaces the contents
+    void clear();
+
+    // Adds or renames a task / drops a task; both are idempotent and ignored until loaded
+    void upsert(int id, const std::string& header);
+    void remove(int id);
+
+    // Up to `limit` (at most maxLimit) headers starting with `prefix` (case-insensitive),
+    // most used first, then alphabetically. An empty prefix matches every header.
+    std::vector<Suggestion> suggest(std::string_view prefix, std::size_t limit) const;
+
+    static std::string normalize(std::string_view header);
+
+private:
+    struct Entry {
+        std::string header;
+        int count = 0;
+    };
+    using Item = const std::pair<const std::string, Entry>*;  // Map nodes are stable
+
+    bool loaded = false;
+    std::map<std::string, Entry, std::less<>> entries;  // By normalized header
+    std::unordered_map<int, std::string> taskKeys;      // Task id -> normalized header
+    mutable std::unordered_map<std::string, std::vector<Item>> cache;  // Prefix -> best maxLimit, in order
+
+    static bool better(Item a, Item b);
+    void add(int id, const std::string& header);
+    void recount(Item item, int delta);  // Changes a count and patches the cached prefixes of its key
+    std::vector<Item> scan(const std::string& prefix) const;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Size limits a request must stay within; exceeding one fails the parse
+struct HttpRequestLimits {
+    std::size_t maxHeadSize = 16 * 1024;  // Request line plus headers
+    std::size_t maxHeaderCount = 100;
+    std::size_t maxBodySize = 1 << 20;    // Decoded body, for Content-Length and chunked alike
+};
+
+// A parsed request. Every field points into the bytes given to the parser (a chunked
+// body points into the parser's decode buffer), so nothing is copied.
+struct HttpRequestView {
+    std::string_view method;
+    std::string_view target;   // As sent, query string included
+    std::string_view path;
+    std::string_view query;    // Raw query string without the leading '?'
+    std::string_view version;  // E.g. "HTTP/1.1"
+    std::vector<std::pair<std::string_view, std::string_view>> headers;  // Names as sent, values trimmed
+    std::string_view body;
+
+    // Value of the first header called `name` (compared case-insensitively), or empty
+    std::string_view header(std::string_view name) const;
+
+    // Whether the connection stays open after this request: the HTTP/1.1 default
+    // unless the client asked to close. HTTP/1.0 connections are always closed.
+    bool keepAlive() const;
+};
+
+// Incremental HTTP/1.x request parser. Give it the unhandled bytes of a connection
+// whenever more arrive; it resumes where the last call stopped (the search for the
+// end of the head, the chunk being decoded) instead of rescanning from the start:
+//   HttpRequestParser parser;
+//   while (parser.parse(input) == HttpRequestParser::Status::COMPLETE) {
+//       handle(parser.request());
+//       input.erase(0, parser.consumed());
+//       parser.reset();
+//   }
+// Between calls `input` may grow (and move), but the bytes already seen must not
+// change. Bodies are framed by Content-Length or chunked Transfer-Encoding.
+class HttpRequestParser {
+public:
+    enum class Status { INCOMPLETE, COMPLETE, FAILED };
+
+    explicit HttpRequestParser(HttpRequestLimits limits = {});
+
+    Status parse(std::string_view input);
+
+    // The request, valid after COMPLETE until `input` changes or the parser is reset
+    const HttpRequestView& request() const { return parsed; }
+
+    // Bytes of `input` the complete request occupied
+    std::size_t consumed() const { return consumedBytes; }
+
+    // After FAILED: the status to answer with (400, 413, 431, 501 or 505) and why
+    int errorStatus() const { return errorCode; }
+    const std::string& errorMessage() const { return errorText; }
+
+    // Starts over for the next request, keeping buffers for reuse
+    void reset();
+
+    // Raw (still URL-encoded) value of query parameter `name`; `found` tells an
+    // empty value from a missing one
+    static std::string_view queryParam(std::string_view query, std::string_view name, bool* found = nullptr);
+
+    // Decodes %XX escapes and '+' in a query string component
+    static std::string urlDecode(std::string_view value);
+
+private:
+    enum class Stage { HEAD, BODY, CHUNK_SIZE, CHUNK_DATA, CHUNK_END, TRAILERS, DONE, ERROR };
+
+    // Byte range of the input; views are only built on completion, as the input
+    // may move while a request is still arriving
+    struct Span {
+        std::size_t offset = 0;
+        std::size_t length = 0;
+    };
+
+    HttpRequestLimits limits;
+    Stage stage = Stage::HEAD;
+    std::size_t start = 0;     // Empty lines skipped before the request line
+    std::size_t scanned = 0;   // Head bytes searched for the blank line so far
+    std::size_t cursor = 0;    // Next unparsed byte once the head is done
+    std::size_t bodyLength = 0;       // Content-Length, or the chunk bytes still to copy
+    std::size_t trailerBytes = 0;
+    Span method, target, version;
+    std::vector<std::pair<Span, Span>> headerSpans;
+    Span fixedBody;
+    bool chunked = false;
+    std::string chunkedBody;
+    HttpRequestView parsed;
+    std::size_t consumedBytes = 0;
+    int errorCode = 0;
+    std::string errorText;
+
+    Status fail(int status, std::string message);
+    Status parseHead(std::string_view input, std::size_t headEnd);
+    Status parseChunked(std::string_view input);
+    Status complete(std::string_view input, std::size_t end);
+};
+
+#endif
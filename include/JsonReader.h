@@ -0,0 +1,77 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "Task.h"
+
+// Validating pull parser for request bodies, the reading counterpart of JsonWriter.
+// It walks the text in place: strings come back as views into it and are only
+// copied (into a scratch buffer) when they contain escapes to decode.
+//   JsonReader json(body);
+//   json.beginObject();
+//   std::string_view key;
+//   while (json.nextMember(key)) {
+//       if (key == "header") header = json.string(); else json.skipValue();
+//   }
+//   json.end();
+// Malformed or unexpected input throws std::runtime_error naming the byte offset.
+class JsonReader {
+public:
+    enum class Type { OBJECT, ARRAY, STRING, NUMBER, BOOLEAN, NULL_VALUE };
+
+    explicit JsonReader(std::string_view text) : text(text) {}
+
+    // Type of the next value, without consuming it
+    Type peek();
+
+    void beginObject();
+    // Reads the next member's key (and its ':'), or consumes the closing '}' and returns false
+    bool nextMember(std::string_view& key);
+    void beginArray();
+    // True when another element follows, or consumes the closing ']' and returns false
+    bool nextElement();
+
+    // The views stay valid until the next string() (for values) or nextMember() (for keys)
+    std::string_view string();
+    long long integer();
+    bool boolean();
+    // Consumes a null and returns true, or returns false when the next value is not null
+    bool null();
+    // Validates and skips one value of any type
+    void skipValue();
+    // Requires that only whitespace remains
+    void end();
+
+    // Reads a task object ("header", "description", "difficulty" and "dueDate"; other
+    // members are skipped) into `task`. Description and due date may be null or absent
+    // and then come back empty. Returns false when header or difficulty is missing;
+    // a difficulty outside the int range reads as 0.
+    bool task(Task& task);
+
+    std::size_t offset() const { return pos; }
+
+    // Objects and arrays nested deeper than this are rejected
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+private:
+    std::string_view text;
+    std::size_t pos = 0;
+    std::size_t depth = 0;
+    bool first[MAX_DEPTH + 1] = {};  // No member/element read yet at this depth
+    std::string valueScratch;  // Decoded string values
+    std::string keyScratch;    // Decoded keys, kept apart so a key survives its value
+
+    [[noreturn]] void fail(const char* what) const;
+    void skipWhitespace();
+    void expect(char c);
+    void enter();
+    bool separator(char close);
+    std::string_view parseString(std::string& scratch);
+    std::string_view parseNumber(bool& integral);
+    unsigned parseHex4();
+    void literal(std::string_view word);
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <string>
+#include <string_view>
+#include "Task.h"
+
+// Streams JSON into a caller-owned buffer, so a whole response (HTTP head included)
+// can be built in one reserved std::string without per-value temporaries.
+// Separators are tracked automatically:
+//   JsonWriter json(out);
+//   json.beginObject().key("tasks").beginArray().task(view).endArray().endObject();
+// Strings use the same escaping the servers have always produced: '"', '\\' and
+// control characters become \u00XX, everything else (including UTF-8) passes through.
+class JsonWriter {
+public:
+    explicit JsonWriter(std::string& out) : out(out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+    JsonWriter& key(std::string_view name);
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(long long number);
+    JsonWriter& value(int number) { return value(static_cast<long long>(number)); }
+    JsonWriter& value(unsigned long long number);
+    JsonWriter& value(double number);  // Shortest round-trip form; NaN and infinities become null
+    JsonWriter& value(bool flag);
+    JsonWriter& null();
+
+    // {"id":..,"header":..,"description":..,"completed":..,"difficulty":..,"dueDate":..}
+    JsonWriter& task(const TaskView& task);
+    JsonWriter& task(const Task& task);
+
+    // Appends `text` escaped, without quotes
+    static void appendEscaped(std::string& out, std::string_view text);
+
+    // Rough serialized size of one task, for reserving buffers
+    static std::size_t estimateTaskSize(const Task& task) { return 96 + task.header.size() + task.description.size(); }
+
+private:
+    std::string& out;
+    bool needsComma = false;  // A value was written at the current nesting level
+    bool afterKey = false;    // The next value completes a "key": pair
+
+    void separate();
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PRIORITY_INDEX_H
+#define PRIORITY_INDEX_H
+
+#include <array>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <cstddef>
+#include "Task.h"
+#include "TaskPrioritizer.h"
+
+// In-memory copy of the open tasks with one ordered key set per strategy.
+// Mutations update it in O(log n) and prioritized reads walk the first k keys,
+// instead of reloading and re-sorting the table on every request.
+// Keys are the same TaskPrioritizer keys with the task id as the final tie-break,
+// so the order matches prioritizing getTasks() (which is in id order).
+// Not thread-safe; ToDoList guards it with its own mutex.
+class PriorityIndex {
+public:
+    using Strategy = TaskPrioritizer::Strategy;
+
+    bool isLoaded() const { return loaded; }
+    void load(std::vector<Task> openTasks);  // Replaces the contents
+    void clear();                            // Drops everything until the next load()
+
+    // Adds or replaces an open task / drops a task; both are idempotent
+    void upsert(const Task& task);
+    void remove(int id);
+
+    // The first `limit` open tasks in priority order (limit 0 = all).
+    // BALANCED scores depend on today's date, so that ordering is rebuilt
+    // the first time it is read after the day changes.
+    std::vector<Task> top(Strategy strategy, std::size_t limit);
+    
+    // Same, with the prioritizer's strategy and weights. WEIGHTED has no
+    // maintained ordering (weights vary per call) and is ranked on the fly.
+    std::vector<Task> top(const TaskPrioritizer& prioritizer, std::size_t limit);
+
+private:
+    struct Ordering {
+        bool built = false;
+        int day = 0;  // Epoch day the keys were computed against
+        std::set<TaskPrioritizer::SortKey> keys;
+    };
+
+    bool loaded = false;
+    std::unordered_map<int, Task> tasks;
+    std::array<Ordering, 3> orderings;  // Indexed by Strategy, WEIGHTED excluded
+
+    static TaskPrioritizer::SortKey keyOf(Strategy strategy, const Task& task, int day);
+    void build(Strategy strategy, int today);
+    std::vector<Task> rank(const TaskPrioritizer& prioritizer, std::size_t limit) const;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef RESPONSE_CACHE_H
+#define RESPONSE_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+
+// Serialized responses for the hot read views (open tasks, completed tasks, each
+// prioritization strategy), shared by all server threads. Each slot holds one
+// immutable entry stamped with the ToDoList data version it was built from plus a
+// variant string (e.g. the ETag, which also carries the date for prioritized views);
+// a mutation bumps the version, so stale entries simply stop matching.
+// Readers load the slot's shared_ptr atomically and never block on a builder; the
+// bytes they get stay alive for as long as they hold the pointer.
+class ResponseCache {
+public:
+    using Bytes = std::shared_ptr<const std::string>;
+
+    explicit ResponseCache(std::size_t slotCount);
+
+    // The cached bytes, or null when the slot holds another version or variant
+    Bytes get(std::size_t slot, std::uint64_t version, std::string_view variant) const;
+
+    // Publishes freshly built bytes and returns them. An entry for a newer version
+    // is kept, so a slow builder cannot replace a more recent response.
+    Bytes put(std::size_t slot, std::uint64_t version, std::string variant, std::string bytes);
+
+    // get(), or build() then put() on a miss. Concurrent misses may both build.
+    template <typename Build>
+    Bytes getOrBuild(std::size_t slot, std::uint64_t version, const std::string& variant, Build&& build) {
+        if (Bytes cached = get(slot, version, variant)) {
+            return cached;
+        }
+        return put(slot, version, variant, build());
+    }
+
+    void clear();
+    std::size_t slotCount() const { return slots.size(); }
+
+private:
+    struct Entry {
+        std::uint64_t version;
+        std::string variant;
+        std::string bytes;
+    };
+
+    // Accessed only through std::atomic_load / std::atomic_compare_exchange_strong
+    std::vector<std::shared_ptr<const Entry>> slots;
+};
+
+#endif
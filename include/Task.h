@@ -3,6 +3,8 @@
 #define TASK_H
 
 #include <string>
+#include <string_view>
+#include "DueDate.h"
 
 struct Task {
     int id;
@@ -11,6 +13,25 @@ struct Task {
     bool completed;
     int difficulty;
     std::string dueDate;
+    int dueDay = NO_DUE_DAY;  // dueDate as an epoch day, filled in when read from the database
+};
+
+// Non-owning view of a task row, handed out by ToDoList::forEachTask.
+// The string_views point into SQLite's row buffers and are only valid
+// for the duration of the visitor call that receives them.
+struct TaskView {
+    int id;
+    std::string_view header;
+    std::string_view description;
+    bool completed;
+    int difficulty;
+    std::string_view dueDate;
+    int dueDay;
+
+    // Copies the row into an owning Task
+    Task toTask() const {
+        return {id, std::string(header), std::string(description), completed, difficulty, std::string(dueDate), dueDay};
+    }
 };
 
 #endif
\ No newline at end of file
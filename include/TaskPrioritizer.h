@@ -1,7 +1,11 @@
 #ifndef TASK_PRIORITIZER_H
 #define TASK_PRIORITIZER_H
 
+#include <optional>
+#include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 #include "Task.h"
 
 class TaskPrioritizer {
@@ -10,21 +14,106 @@ public:
     enum class Strategy {
         DUE_DATE_FIRST,    // Prioritize by due date, then difficulty
         DIFFICULTY_FIRST,  // Prioritize by difficulty, then due date
-        BALANCED           // Use a weighted algorithm
+        BALANCED,          // Use a weighted algorithm
+        WEIGHTED           // Additive score with caller-chosen weights (see Weights)
+    };
+    
+    // Weights of the WEIGHTED strategy. A task's score is
+    // dueDate * days_until_due - difficulty * difficulty (lower is more urgent);
+    // past-due tasks count as due today and undated tasks come last.
+    struct Weights {
+        double dueDate = 1.0;
+        double difficulty = 1.0;
     };
     
     TaskPrioritizer(Strategy strategy = Strategy::BALANCED);
+    TaskPrioritizer(Weights weights);  // WEIGHTED with the given weights
     void setStrategy(Strategy strategy);
+    Strategy getStrategy() const { return currentStrategy; }
+    
+    // Throws std::runtime_error unless both weights are finite and non-negative
+    void setWeights(Weights weights);
+    Weights getWeights() const { return currentWeights; }
+    
+    // Stable names used by the HTTP APIs ("due_date_first", "difficulty_first",
+    // "balanced", "weighted")
+    static const std::vector<Strategy>& allStrategies();
+    static const char* strategyName(Strategy strategy);
+    static const char* strategyTitle(Strategy strategy);  // Display name, e.g. "Due Date First"
+    static const char* strategyDescription(Strategy strategy);
+    static std::optional<Strategy> strategyFromName(const std::string& name);
+    
+    // The prioritizer an API request asks for: `name` is a strategyName (BALANCED when
+    // empty) and the weights, when given, require "weighted" (unset ones keep their
+    // defaults). Throws std::invalid_argument with a message meant for the client.
+    static TaskPrioritizer fromParameters(const std::string& name, const std::string& dueWeight,
+                                          const std::string& difficultyWeight);
+    
+    // Inputs below this size are always prioritized serially
+    static constexpr std::size_t DEFAULT_PARALLEL_THRESHOLD = 100000;
+    
+    // Enables the parallel path of prioritizeTasks for large inputs: keys are computed,
+    // sorted and applied in chunks on `threads` threads (0 = one per core, 1 = serial,
+    // the default) and the sorted chunks are merged. Keys are totally ordered (ties fall
+    // back to input position), so the result is identical to the serial path.
+    void setParallelism(unsigned threads, std::size_t threshold = DEFAULT_PARALLEL_THRESHOLD);
+    
+    // Sorts tasks in place by priority. Ties keep their input order.
+    void prioritizeTasks(std::vector<Task>& tasks) const;
+    
+    // Keeps only the k highest-priority tasks, in priority order. Uses a partial
+    // (heap) selection, O(n log k), and matches the first k of prioritizeTasks.
+    void prioritizeTopK(std::vector<Task>& tasks, std::size_t k) const;
     
-    // Sorts tasks in place by priority
-    void prioritizeTasks(std::vector<Task>& tasks);
+    // Compact numeric key computed once per task, so the sort compares plain
+    // numbers and moves 16-byte keys instead of re-deriving dates from Tasks
+    struct SortKey {
+        double primary;
+        int secondary;
+        std::uint32_t index;  // Position in the input (or task id); the final tie-break
+
+        bool operator<(const SortKey& other) const {
+            if (primary != other.primary) return primary < other.primary;
+            if (secondary != other.secondary) return secondary < other.secondary;
+            return index < other.index;
+        }
+    };
+
+    // Key of one task under the current strategy; `today` is the epoch day BALANCED
+    // and WEIGHTED measure from
+    SortKey keyFor(const Task& task, std::uint32_t index, int today) const;
+    
+    // Structure-of-arrays view of a batch of tasks for bulk BALANCED scoring
+    struct TaskBatch {
+        const std::int32_t* dueDays;       // Epoch days, NO_DUE_DAY for none
+        const std::int32_t* difficulties;
+        std::size_t size;
+    };
+    
+    // BALANCED score of one task: days until due (0 when past due) / difficulty,
+    // or FLT_MAX without a due date. Lower is more urgent.
+    static float balancedScore(int dueDay, int difficulty, int today);
+    
+    // Primary WEIGHTED score of one task (see Weights); DBL_MAX without a due date
+    static double weightedScore(int dueDay, int difficulty, int today, Weights weights);
+    
+    // Writes balancedScore for every task of the batch into `scores`. Uses an AVX2
+    // kernel when the CPU supports it (checked once at runtime), otherwise a scalar
+    // loop; both produce bit-identical results.
+    static void scoreBalanced(const TaskBatch& batch, int today, float* scores);
     
 private:
     Strategy currentStrategy;
-    // Helper methods for different strategies
-    void sortByDueDate(std::vector<Task>& tasks) const;
-    void sortByDifficulty(std::vector<Task>& tasks) const;
-    void sortBalanced(std::vector<Task>& tasks) const;
+    Weights currentWeights;
+    unsigned parallelThreads = 1;
+    std::size_t parallelThreshold = DEFAULT_PARALLEL_THRESHOLD;
+
+    // Helper methods; each strategy is a key policy type (see TaskPrioritizer.cpp)
+    // dispatched once per batch, so key extraction is inlined into the loop
+    std::vector<SortKey> computeKeys(const std::vector<Task>& tasks) const;
+    void computeKeys(const std::vector<Task>& tasks, std::size_t begin, std::size_t end, int today, SortKey* keys) const;
+    static void applyOrder(std::vector<Task>& tasks, const std::vector<SortKey>& keys);
+    void prioritizeParallel(std::vector<Task>& tasks, unsigned threads) const;
 };
 
-#endif
\ No newline at end of file
+#endif
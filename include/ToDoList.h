@@ -4,42 +4,280 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <array>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <thread>
+#include <optional>
+#include <mutex>
 #include <sqlite3.h>
 #include "Task.h"
+#include "TaskPrioritizer.h"
+#include "PriorityIndex.h"
+#include "HeaderSuggester.h"
+
+// Decodes the current row of a statement selecting
+// id, header, description, completed, difficulty, dueDate, dueDay (in that order)
+inline TaskView viewTaskRow(sqlite3_stmt* stmt) {
+    auto text = [stmt](int col) {
+        // sqlite3_column_bytes must come after sqlite3_column_text for the length to match
+        const char* data = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+        return data ? std::string_view(data, sqlite3_column_bytes(stmt, col)) : std::string_view();
+    };
+    int dueDay = sqlite3_column_type(stmt, 6) == SQLITE_NULL ? NO_DUE_DAY : sqlite3_column_int(stmt, 6);
+    return {sqlite3_column_int(stmt, 0), text(1), text(2), sqlite3_column_int(stmt, 3) != 0,
+            sqlite3_column_int(stmt, 4), text(5), dueDay};
+}
+
+// Filters and cursor for paged listing. Pages are keyed on id (keyset pagination),
+// so each page is an index range scan no matter how deep the client has paged.
+struct TaskQuery {
+    bool completed = false;          // List completed instead of open tasks
+    int limit = 50;                  // Page size, clamped to [1, maxLimit]
+    int afterId = 0;                 // Only tasks with id > afterId (the previous page's nextCursor)
+    std::optional<int> difficulty;   // Exact difficulty match
+    std::string dueFrom;             // Inclusive YYYY-MM-DD bounds; empty means unbounded.
+    std::string dueTo;               // Tasks without a due date never match a bounded range.
+                                     // Compared as epoch days against the indexed dueDay column.
+
+    static constexpr int maxLimit = 1000;
+};
+
+struct TaskPage {
+    std::vector<Task> tasks;
+    std::optional<int> nextCursor;   // Pass as afterId for the next page; empty on the last page
+};
+
+// Opt-in write coalescing, see ToDoList::setGroupCommit
+struct GroupCommitOptions {
+    bool enabled = false;
+    std::chrono::microseconds window{2000};  // How long the first write of a batch waits for company
+    std::size_t maxBatch = 256;              // Commit as soon as this many writes are queued
+    
+    // The servers' setting: TODO_GROUP_COMMIT_US=<window> enables group commit with that
+    // window in microseconds; 0, unset or invalid (reported on stderr) leaves it disabled
+    static GroupCommitOptions fromEnvironment();
+};
 
 class ToDoList { 
 public:
     ToDoList();
+    ~ToDoList();
+    // Opens the single writer connection (WAL mode) and migrates the schema.
+    // Read connections are opened lazily, one per concurrently reading thread.
     void connect(const std::string& dbPath);
     
     // Basic CRUD operations
-    void addTask(const std::string& header, const std::string& description, int difficulty, const std::string& dueDate);
+    int addTask(const std::string& header, const std::string& description, int difficulty, const std::string& dueDate);  // Returns the new id
+    // Inserts all tasks in one transaction (all or nothing); returns the new ids in input order.
+    // Only header, description, difficulty and dueDate of each task are used.
+    std::vector<int> addTasks(const std::vector<Task>& tasks);
     void deleteTask(int id);
     void editTask(int id, const std::string& header, const std::string& description, int difficulty, const std::string& dueDate);
     std::vector<Task> getTasks() const;  // By creation order
     
+    // Primary-key lookups (open and completed tasks alike)
+    std::optional<Task> getTaskById(int id) const;
+    std::vector<Task> getTasksByIds(const std::vector<int>& ids) const;  // In request order, missing ids skipped
+    
     // Task status
     bool markTaskAsCompleted(int id);
     bool unmarkTaskAsCompleted(int id);  // New "undo complete" feature
     std::vector<Task> getCompletedTasks() const;  // View completed tasks
     
-    // Task prioritization
-    std::vector<Task> getPrioritizedTasks() const;
+    // One page of open or completed tasks in id order
+    TaskPage getTasksPage(const TaskQuery& query) const;
+    
+    // Full-text search over header and description (open and completed tasks),
+    // best match first. Words in `text` are matched literally and must all occur;
+    // the last one also matches as a prefix. limit 0 = all matches.
+    std::vector<Task> searchTasks(const std::string& text, std::size_t limit = 20) const;
+    
+    // Type-ahead for task headers: up to `limit` distinct headers (open and completed
+    // tasks) starting with `prefix`, case-insensitive, most used first. Served from an
+    // in-memory prefix index loaded on first use and kept up to date by the mutations.
+    std::vector<HeaderSuggester::Suggestion> suggestHeaders(const std::string& prefix, std::size_t limit = 10) const;
+    
+    // Stream open / completed tasks in id order to visit(const TaskView&) without
+    // materializing them; the views are only valid during each call
+    template <typename Visitor>
+    void forEachTask(Visitor&& visit) const { visitRows(false, visit); }
+    template <typename Visitor>
+    void forEachCompletedTask(Visitor&& visit) const { visitRows(true, visit); }
+    
+    // Task prioritization, served from an in-memory index kept up to date by the
+    // mutations above (this ToDoList must be the only writer to the database file)
+    std::vector<Task> getPrioritizedTasks(std::size_t limit = 0) const;  // BALANCED; limit 0 = all open tasks
+    std::vector<Task> getPrioritizedTasks(TaskPrioritizer::Strategy strategy, std::size_t limit = 0) const;
+    std::vector<Task> getPrioritizedTasks(const TaskPrioritizer& prioritizer, std::size_t limit = 0) const;  // E.g. WEIGHTED with custom weights
+    
+    // Group commit: when enabled, concurrent mutations (add, batch add, edit, delete,
+    // mark/unmark) are queued and a committer thread runs up to maxBatch of them in one
+    // transaction (one fsync), each inside its own savepoint. Every caller still blocks
+    // until its own write has committed and gets its own result or exception; a failing
+    // write is rolled back alone. Worth it only with several writing threads.
+    void setGroupCommit(const GroupCommitOptions& options);
+    
+    // Data version, bumped after every committed mutation (and on connect) once the
+    // in-memory indexes reflect it. The tag adds a random per-instance salt, so it never
+    // repeats across restarts: "<salt>-<version>", e.g. for HTTP ETags. Read it before
+    // querying, so a write that lands in between only makes the tag older than the data.
+    // Like the priority index, this assumes no other process writes the database.
+    std::uint64_t getDataVersion() const { return dataVersion.load(std::memory_order_acquire); }
+    std::string getDataVersionTag() const;
+    
+    // How getPrioritizedTasks orders tasks. IN_MEMORY (the default) serves them from
+    // the index above; SQL has SQLite return rows already ordered (ORDER BY ... LIMIT
+    // over matching indexes, or the balanced_score/weighted_score SQL functions) and
+    // keeps nothing in memory. Both engines return the same order.
+    enum class PriorityEngine { IN_MEMORY, SQL };
+    void setPriorityEngine(PriorityEngine engine);
+    PriorityEngine getPriorityEngine() const { return priorityEngine; }
     
 private:
-    // Smart pointer for memory safety, prevents memory leaks before the destructor is called
-    std::unique_ptr<sqlite3, decltype(&sqlite3_close)> db{nullptr, sqlite3_close};
-
-    // Cached statements
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> addTaskStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getTasksStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> markCompletedStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> deleteTaskStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> editTaskStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> unmarkCompletedStmt{nullptr, sqlite3_finalize};
-    std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getCompletedTasksStmt{nullptr, sqlite3_finalize};
-    
-    void prepareStatements(); // Initialize prepared statements
+    // One SQLite connection with its own set of cached statements. Connections are
+    // opened with SQLITE_OPEN_NOMUTEX, so each one is only ever used by one thread at a time.
+    struct Connection {
+        // Smart pointer for memory safety, prevents memory leaks before the destructor is called
+        std::unique_ptr<sqlite3, decltype(&sqlite3_close)> db{nullptr, sqlite3_close};
+
+        // Cached statements
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> addTaskStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getTasksStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> markCompletedStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> deleteTaskStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> editTaskStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> unmarkCompletedStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getCompletedTasksStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getTaskByIdStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getTasksPageStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> searchTasksStmt{nullptr, sqlite3_finalize};
+        std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)> getHeadersStmt{nullptr, sqlite3_finalize};
+        
+        // Open tasks in priority order, one statement per TaskPrioritizer::Strategy
+        std::array<std::unique_ptr<sqlite3_stmt, decltype(&sqlite3_finalize)>, 4> prioritizedStmts{{
+            {nullptr, sqlite3_finalize}, {nullptr, sqlite3_finalize},
+            {nullptr, sqlite3_finalize}, {nullptr, sqlite3_finalize}}};
+
+        void prepareStatements(); // Initialize prepared statements
+    };
+
+    // Borrows a read connection from the pool for the lifetime of the lease.
+    // In-memory databases cannot be shared between connections, so there the
+    // lease falls back to the writer connection under the writer lock.
+    class ReadLease {
+    public:
+        explicit ReadLease(const ToDoList& owner);
+        ~ReadLease();
+        ReadLease(const ReadLease&) = delete;
+        ReadLease& operator=(const ReadLease&) = delete;
+
+        Connection* operator->() const { return conn; }
+
+    private:
+        const ToDoList& owner;
+        std::unique_ptr<Connection> pooled;
+        std::unique_lock<std::mutex> writerLock;
+        Connection* conn = nullptr;
+    };
+
+    std::string dbPath;
+    bool sharedCache = false;  // True for in-memory databases (reads go through the writer)
+
+    // All mutations are serialized through the single writer connection
+    std::unique_ptr<Connection> writer;
+    mutable std::mutex writerMutex;
+
+    // Idle read connections, grown on demand up to the number of concurrent readers
+    mutable std::mutex readersMutex;
+    mutable std::vector<std::unique_ptr<Connection>> idleReaders;
+    
+    // Resets a cached statement on every way out: a scan never returns its connection to
+    // the pool still holding a read snapshot, and a failed write leaves nothing pending
+    // on the writer when its transaction or savepoint is rolled back
+    struct StatementReset {
+        sqlite3_stmt* stmt;
+        ~StatementReset() { sqlite3_reset(stmt); }
+    };
+    
+    // Throws unless a step loop ended with SQLITE_DONE rather than an error mid-scan
+    static void checkScanDone(int rc, sqlite3* db, const char* what);
+    
+    template <typename Visitor>
+    void visitRows(bool completed, Visitor& visit) const {
+        ReadLease reader(*this);
+        sqlite3_stmt* stmt = completed ? reader->getCompletedTasksStmt.get() : reader->getTasksStmt.get();
+        
+        sqlite3_reset(stmt);
+        StatementReset reset{stmt};
+        int rc;
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+            visit(viewTaskRow(stmt));
+        }
+        checkScanDone(rc, reader->db.get(), "Failed to read tasks");
+    }
+
+    std::atomic<std::uint64_t> dataVersion{0};
+    std::uint64_t dataVersionSalt;
+    void bumpDataVersion() { dataVersion.fetch_add(1, std::memory_order_acq_rel); }
+    
+    // Open tasks in priority order, loaded by the first prioritized read.
+    // Lock order: writerMutex before priorityMutex. indexGeneration counts
+    // mutations so a load racing with a write can tell its snapshot is stale.
+    mutable std::mutex priorityMutex;
+    mutable PriorityIndex priorityIndex;
+    mutable unsigned long long indexGeneration = 0;
+    std::atomic<PriorityEngine> priorityEngine{PriorityEngine::IN_MEMORY};
+
+    // Header prefix index, loaded by the first suggestHeaders call. Same locking
+    // scheme as the priority index: writerMutex before suggestMutex.
+    mutable std::mutex suggestMutex;
+    mutable HeaderSuggester headerSuggester;
+    mutable unsigned long long suggestGeneration = 0;
+
+    void indexTasks(const std::vector<Task>& tasks);  // Upsert open / drop completed, after a commit
+    void unindexTask(int id);
+    void refreshIndexedTask(int id);  // Re-reads one row through the writer; writer lock must be held
+    void suggestTaskHeaders(const std::vector<Task>& tasks);  // Record added headers
+    void suggestTaskHeader(int id, const std::string& header);  // Record an edited header
+    void unsuggestTask(int id);
+    // A mutation split into its SQL (run under the writer lock, possibly inside a group
+    // transaction) and its index updates (run after the commit). `atomic` wraps a
+    // multi-statement execute in its own transaction when not group committing.
+    void write(const std::function<void()>& execute, const std::function<void()>& publish, bool atomic = false);
+    // Runs publish after a commit and bumps the data version even when it throws; a
+    // failed publish drops the indexes so the next read reloads them from the database
+    void publishCommitted(const std::function<void()>& publish);
+    void dropIndexes();  // Takes priorityMutex and suggestMutex
+    
+    struct PendingWrite {
+        const std::function<void()>* execute;
+        const std::function<void()>* publish;
+        std::exception_ptr error;
+        bool finished = false;
+    };
+    
+    // Group commit state; lock order: groupMutex is never held while taking writerMutex
+    std::mutex groupMutex;
+    std::condition_variable groupReady;  // Committer: work queued or stopping
+    std::condition_variable groupDone;   // Writers: a batch finished
+    std::deque<PendingWrite*> groupQueue;
+    GroupCommitOptions groupCommit;
+    bool groupStopping = false;
+    std::thread groupCommitter;
+    
+    void runGroupCommits();
+    void commitBatch(const std::vector<PendingWrite*>& batch);
+    
+    std::vector<Task> queryPrioritizedTasks(const TaskPrioritizer& prioritizer, std::size_t limit) const;  // SQL engine
+
+    std::unique_ptr<Connection> openConnection(bool readOnly) const;
+    void runMigrations();     // Bring the schema up to the latest user_version
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#include "DbExecutor.h"
+
+DbExecutor::DbExecutor(unsigned readThreads, unsigned writeThreads, std::size_t queueCapacity) {
+    if (readThreads == 0) {
+        readThreads = std::thread::hardware_concurrency();
+    }
+    start(reads, readThreads > 0 ? readThreads : 1, queueCapacity);
+    start(writes, writeThreads > 0 ? writeThreads : 1, queueCapacity);
+}
+
+DbExecutor::~DbExecutor() {
+    shutdown();
+}
+
+void DbExecutor::start(Queue& queue, unsigned threads, std::size_t capacity) {
+    queue.capacity = capacity;
+    queue.workers.reserve(threads);
+    for (unsigned i = 0; i < threads; ++i) {
+        queue.workers.emplace_back([&queue] { work(queue); });
+    }
+}
+
+bool DbExecutor::submit(Lane lane, std::function<void()> job) {
+    Queue& queue = queueFor(lane);
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.stopping || queue.jobs.size() >= queue.capacity) {
+            return false;
+        }
+        queue.jobs.push_back(std::move(job));
+    }
+    queue.ready.notify_one();
+    return true;
+}
+
+void DbExecutor::work(Queue& queue) {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(queue.mutex);
+            queue.ready.wait(lock, [&queue] { return queue.stopping || !queue.jobs.empty(); });
+            if (queue.jobs.empty()) {
+                return;  // Stopping and drained
+            }
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+        }
+        
+        try {
+            job();
+        } catch (...) {
+            // Keep the worker alive; the job is responsible for reporting failures
+        }
+    }
+}
+
+void DbExecutor::stop(Queue& queue) {
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.stopping = true;
+    }
+    queue.ready.notify_all();
+    for (auto& worker : queue.workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    queue.workers.clear();
+}
+
+void DbExecutor::shutdown() {
+    stop(reads);
+    stop(writes);
+}
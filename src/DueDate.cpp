@@ -0,0 +1,45 @@
+#include "DueDate.h"
+#include <ctime>
+
+// Days from 1970-01-01 to the given proleptic Gregorian date
+// (Howard Hinnant's days_from_civil)
+static int daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int era = (year >= 0 ? year : year - 399) / 400;
+    const int yearOfEra = year - era * 400;
+    const int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int epochDayFromDate(std::string_view date) {
+    if (date.size() != 10 || date[4] != '-' || date[7] != '-') {
+        return NO_DUE_DAY;
+    }
+    
+    int fields[3] = {0, 0, 0};
+    const int starts[3] = {0, 5, 8};
+    const int lengths[3] = {4, 2, 2};
+    for (int f = 0; f < 3; ++f) {
+        for (int i = 0; i < lengths[f]; ++i) {
+            char c = date[starts[f] + i];
+            if (c < '0' || c > '9') {
+                return NO_DUE_DAY;
+            }
+            fields[f] = fields[f] * 10 + (c - '0');
+        }
+    }
+    
+    int year = fields[0], month = fields[1], day = fields[2];
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return NO_DUE_DAY;
+    }
+    return daysFromCivil(year, month, day);
+}
+
+int currentEpochDay() {
+    std::time_t now = std::time(nullptr);
+    std::tm local = {};
+    localtime_r(&now, &local);
+    return daysFromCivil(local.tm_year + 1900, local.tm_mon + 1, local.tm_mday);
+}
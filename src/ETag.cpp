@@ -0,0 +1,33 @@
+#include "ETag.h"
+#include "ToDoList.h"
+
+std::string dataETag(const ToDoList& todoList, const std::string& variant) {
+    std::string etag = "\"" + todoList.getDataVersionTag();
+    if (!variant.empty()) {
+        etag += "-" + variant;
+    }
+    return etag + "\"";
+}
+
+bool etagMatches(std::string_view ifNoneMatch, std::string_view etag) {
+    std::size_t pos = 0;
+    while (pos < ifNoneMatch.size()) {
+        std::size_t end = ifNoneMatch.find(',', pos);
+        if (end == std::string_view::npos) {
+            end = ifNoneMatch.size();
+        }
+        std::size_t start = ifNoneMatch.find_first_not_of(" \t", pos);
+        std::size_t last = ifNoneMatch.find_last_not_of(" \t", end - 1);
+        if (start != std::string_view::npos && start < end && last >= start) {
+            std::string_view candidate = ifNoneMatch.substr(start, last - start + 1);
+            if (candidate.substr(0, 2) == "W/") {
+                candidate.remove_prefix(2);
+            }
+            if (candidate == "*" || candidate == etag) {
+                return true;
+            }
+        }
+        pos = end + 1;
+    }
+    return false;
+}
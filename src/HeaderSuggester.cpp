@@ -0,0 +1,157 @@
+#include "HeaderSuggester.h"
+#include <algorithm>
+#include <cctype>
+
+std::string HeaderSuggester::normalize(std::string_view header) {
+    std::size_t begin = 0;
+    std::size_t end = header.size();
+    while (begin < end && std::isspace(static_cast<unsigned char>(header[begin]))) {
+        ++begin;
+    }
+    while (end > begin && std::isspace(static_cast<unsigned char>(header[end - 1]))) {
+        --end;
+    }
+    
+    std::string key(header.substr(begin, end - begin));
+    for (char& c : key) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return key;
+}
+
+// Most used first, then alphabetically
+bool HeaderSuggester::better(Item a, Item b) {
+    return a->second.count != b->second.count ? a->second.count > b->second.count : a->first < b->first;
+}
+
+void HeaderSuggester::load(const std::vector<std::pair<int, std::string>>& headers) {
+    clear();
+    taskKeys.reserve(headers.size());
+    loaded = true;
+    for (const auto& [id, header] : headers) {
+        add(id, header);
+    }
+}
+
+void HeaderSuggester::clear() {
+    loaded = false;
+    entries.clear();
+    taskKeys.clear();
+    cache.clear();
+}
+
+void HeaderSuggester::add(int id, const std::string& header) {
+    std::string key = normalize(header);
+    if (key.empty()) {
+        return;
+    }
+    
+    auto entry = entries.try_emplace(key).first;
+    entry->second.header = header;
+    recount(&*entry, +1);
+    taskKeys.emplace(id, std::move(key));
+}
+
+void HeaderSuggester::upsert(int id, const std::string& header) {
+    if (!loaded) {
+        return;
+    }
+    remove(id);
+    add(id, header);
+}
+
+void HeaderSuggester::remove(int id) {
+    auto task = taskKeys.find(id);
+    if (task == taskKeys.end()) {
+        return;
+    }
+    
+    auto entry = entries.find(task->second);
+    if (entry != entries.end()) {
+        recount(&*entry, -1);
+        if (entry->second.count == 0) {
+            entries.erase(entry);
+        }
+    }
+    taskKeys.erase(task);
+}
+
+void HeaderSuggester::recount(Item item, int delta) {
+    const_cast<Entry&>(item->second).count += delta;
+    if (cache.empty()) {
+        return;
+    }
+    
+    const std::string& key = item->first;
+    for (std::size_t length = 0; length <= key.size(); ++length) {
+        auto cached = cache.find(key.substr(0, length));
+        if (cached == cache.end()) {
+            continue;
+        }
+        
+        std::vector<Item>& best = cached->second;
+        auto it = std::find(best.begin(), best.end(), item);
+        bool complete = best.size() < maxLimit;  // The list holds the whole prefix range
+        if (delta > 0) {
+            // A count went up: it can only enter the list or move up in it
+            if (it == best.end()) {
+                if (complete) {
+                    best.push_back(item);
+                } else if (better(item, best.back())) {
+                    best.back() = item;
+                }
+            }
+        } else if (it != best.end()) {
+            // A listed count went down: an unlisted entry may now belong in a full list
+            if (!complete) {
+                cache.erase(cached);
+                continue;
+            }
+            if (item->second.count == 0) {
+                best.erase(it);
+            }
+        }
+        std::sort(best.begin(), best.end(), better);
+    }
+}
+
+std::vector<HeaderSuggester::Suggestion> HeaderSuggester::suggest(std::string_view prefix, std::size_t limit) const {
+    std::string key = normalize(prefix);
+    
+    auto cached = cache.find(key);
+    if (cached == cache.end()) {
+        // Bound the cache; it refills with whatever is being typed now
+        if (cache.size() >= 4096) {
+            cache.clear();
+        }
+        cached = cache.emplace(key, scan(key)).first;
+    }
+    
+    const auto& best = cached->second;
+    std::size_t count = std::min(limit, best.size());
+    std::vector<Suggestion> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back({best[i]->second.header, best[i]->second.count});
+    }
+    return result;
+}
+
+std::vector<HeaderSuggester::Item> HeaderSuggester::scan(const std::string& prefix) const {
+    // Walk the prefix range keeping the best maxLimit entries in a heap whose front is
+    // the worst kept one. The range is alphabetical, so a later entry with an equal
+    // count never displaces an earlier one.
+    std::vector<Item> best;
+    for (auto it = entries.lower_bound(prefix); it != entries.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it) {
+        if (best.size() < maxLimit) {
+            best.push_back(&*it);
+            std::push_heap(best.begin(), best.end(), better);
+        } else if (it->second.count > best.front()->second.count) {
+            std::pop_heap(best.begin(), best.end(), better);
+            best.back() = &*it;
+            std::push_heap(best.begin(), best.end(), better);
+        }
+    }
+    std::sort_heap(best.begin(), best.end(), better);
+    return best;
+}
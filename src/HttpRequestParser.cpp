@@ -0,0 +1,372 @@
+#include "HttpRequestParser.h"
+#include <algorithm>
+#include <charconv>
+
+namespace {
+
+// Longest chunk-size line (size plus extensions) accepted before the data
+constexpr std::size_t MAX_CHUNK_LINE = 1024;
+
+char toLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (toLower(a[i]) != toLower(b[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether the comma-separated header value lists `token` (case-insensitive)
+bool hasToken(std::string_view value, std::string_view token) {
+    while (!value.empty()) {
+        std::size_t comma = value.find(',');
+        std::string_view item = value.substr(0, comma);
+        std::size_t first = item.find_first_not_of(" \t");
+        std::size_t last = item.find_last_not_of(" \t");
+        if (first != std::string_view::npos && equalsIgnoreCase(item.substr(first, last - first + 1), token)) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        value.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+// RFC 9110 token characters, as allowed in methods and header names
+bool isTokenChar(char c) {
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+        return true;
+    }
+    return std::string_view("!#$%&'*+-.^_`|~").find(c) != std::string_view::npos;
+}
+
+bool isToken(std::string_view text) {
+    if (text.empty()) {
+        return false;
+    }
+    for (char c : text) {
+        if (!isTokenChar(c)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace
+
+std::string_view HttpRequestView::header(std::string_view name) const {
+    for (const auto& field : headers) {
+        if (equalsIgnoreCase(field.first, name)) {
+            return field.second;
+        }
+    }
+    return {};
+}
+
+bool HttpRequestView::keepAlive() const {
+    return version == "HTTP/1.1" && !hasToken(header("Connection"), "close");
+}
+
+HttpRequestParser::HttpRequestParser(HttpRequestLimits limits) : limits(limits) {}
+
+void HttpRequestParser::reset() {
+    stage = Stage::HEAD;
+    start = scanned = cursor = 0;
+    bodyLength = trailerBytes = 0;
+    method = target = version = fixedBody = Span{};
+    headerSpans.clear();
+    chunked = false;
+    chunkedBody.clear();
+    parsed.headers.clear();
+    parsed.method = parsed.target = parsed.path = parsed.query = parsed.version = parsed.body = {};
+    consumedBytes = 0;
+    errorCode = 0;
+    errorText.clear();
+}
+
+HttpRequestParser::Status HttpRequestParser::fail(int status, std::string message) {
+    stage = Stage::ERROR;
+    errorCode = status;
+    errorText = std::move(message);
+    return Status::FAILED;
+}
+
+HttpRequestParser::Status HttpRequestParser::parse(std::string_view input) {
+    switch (stage) {
+    case Stage::DONE:
+        return Status::COMPLETE;
+    case Stage::ERROR:
+        return Status::FAILED;
+    case Stage::HEAD: {
+        // Tolerate empty lines before the request line (e.g. a stray CRLF after a body)
+        while (scanned == start && input.size() >= start + 2 && input[start] == '\r' && input[start + 1] == '\n') {
+            start += 2;
+            scanned = start;
+        }
+        std::size_t headEnd = input.find("\r\n\r\n", scanned);
+        if (headEnd == std::string_view::npos) {
+            if (input.size() - start > limits.maxHeadSize) {
+                return fail(431, "Request header too large");
+            }
+            // The next search starts where a split "\r\n\r\n" could begin
+            scanned = input.size() > start + 3 ? input.size() - 3 : start;
+            return Status::INCOMPLETE;
+        }
+        if (headEnd + 4 - start > limits.maxHeadSize) {
+            return fail(431, "Request header too large");
+        }
+        Status status = parseHead(input, headEnd);
+        if (status == Status::FAILED) {
+            return status;
+        }
+        cursor = headEnd + 4;
+        if (!chunked && fixedBody.length == 0) {
+            return complete(input, cursor);
+        }
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (stage == Stage::BODY) {
+        if (input.size() < fixedBody.offset + fixedBody.length) {
+            return Status::INCOMPLETE;
+        }
+        return complete(input, fixedBody.offset + fixedBody.length);
+    }
+    return parseChunked(input);
+}
+
+HttpRequestParser::Status HttpRequestParser::parseHead(std::string_view input, std::size_t headEnd) {
+    // Request line: method SP target SP version
+    std::size_t lineEnd = input.find("\r\n", start);
+    std::string_view line = input.substr(start, lineEnd - start);
+    std::size_t methodEnd = line.find(' ');
+    std::size_t targetEnd = methodEnd == std::string_view::npos ? methodEnd : line.find(' ', methodEnd + 1);
+    if (targetEnd == std::string_view::npos || !isToken(line.substr(0, methodEnd)) || targetEnd == methodEnd + 1) {
+        return fail(400, "Malformed request line");
+    }
+    std::string_view targetText = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+    std::string_view versionText = line.substr(targetEnd + 1);
+    for (char c : targetText) {
+        if (static_cast<unsigned char>(c) <= ' ' || c == 0x7f) {
+            return fail(400, "Malformed request target");
+        }
+    }
+    if (versionText.size() != 8 || versionText.substr(0, 5) != "HTTP/" || versionText[6] != '.') {
+        return fail(400, "Malformed HTTP version");
+    }
+    if (versionText[5] != '1' || (versionText[7] != '0' && versionText[7] != '1')) {
+        return fail(505, "HTTP version not supported");
+    }
+    method = {start, methodEnd};
+    target = {start + methodEnd + 1, targetText.size()};
+    version = {start + targetEnd + 1, versionText.size()};
+
+    // Header fields, one "Name: value" per line up to the blank line
+    bool hasContentLength = false;
+    std::size_t contentLength = 0;
+    std::size_t lineStart = lineEnd + 2;
+    while (lineStart < headEnd + 2) {
+        lineEnd = input.find("\r\n", lineStart);
+        line = input.substr(lineStart, lineEnd - lineStart);
+        std::size_t colon = line.find(':');
+        if (colon == std::string_view::npos || !isToken(line.substr(0, colon))) {
+            // Also rejects obsolete line folding and whitespace before the colon
+            return fail(400, "Malformed header field");
+        }
+        if (headerSpans.size() == limits.maxHeaderCount) {
+            return fail(431, "Too many header fields");
+        }
+        std::string_view name = line.substr(0, colon);
+        std::size_t valueStart = line.find_first_not_of(" \t", colon + 1);
+        std::size_t valueEnd = line.find_last_not_of(" \t");
+        Span value{lineStart + line.size(), 0};
+        if (valueStart != std::string_view::npos) {
+            value = {lineStart + valueStart, valueEnd - valueStart + 1};
+        }
+        headerSpans.push_back({{lineStart, colon}, value});
+
+        std::string_view valueText = input.substr(value.offset, value.length);
+        if (equalsIgnoreCase(name, "content-length")) {
+            std::size_t length = 0;
+            auto result = std::from_chars(valueText.data(), valueText.data() + valueText.size(), length);
+            if (valueText.empty() || result.ec == std::errc::invalid_argument ||
+                result.ptr != valueText.data() + valueText.size()) {
+                return fail(400, "Malformed Content-Length");
+            }
+            if (result.ec == std::errc::result_out_of_range || length > limits.maxBodySize) {
+                return fail(413, "Request body too large");
+            }
+            if (hasContentLength && length != contentLength) {
+                return fail(400, "Conflicting Content-Length");
+            }
+            hasContentLength = true;
+            contentLength = length;
+        } else if (equalsIgnoreCase(name, "transfer-encoding")) {
+            if (chunked || !equalsIgnoreCase(valueText, "chunked")) {
+                return fail(501, "Unsupported Transfer-Encoding");
+            }
+            chunked = true;
+        }
+        lineStart = lineEnd + 2;
+    }
+
+    // A request with both is a smuggling attempt or a broken proxy; refuse it
+    if (chunked && hasContentLength) {
+        return fail(400, "Both Content-Length and Transfer-Encoding given");
+    }
+    fixedBody = {headEnd + 4, contentLength};
+    stage = chunked ? Stage::CHUNK_SIZE : Stage::BODY;
+    return Status::INCOMPLETE;
+}
+
+HttpRequestParser::Status HttpRequestParser::parseChunked(std::string_view input) {
+    for (;;) {
+        switch (stage) {
+        case Stage::CHUNK_SIZE: {
+            std::size_t lineEnd = input.find("\r\n", cursor);
+            if (lineEnd == std::string_view::npos) {
+                if (input.size() - cursor > MAX_CHUNK_LINE) {
+                    return fail(400, "Malformed chunk size");
+                }
+                return Status::INCOMPLETE;
+            }
+            // Hex size, optionally followed by ";extensions", which are ignored
+            const char* first = input.data() + cursor;
+            const char* last = input.data() + lineEnd;
+            std::size_t size = 0;
+            auto result = std::from_chars(first, last, size, 16);
+            if (result.ec == std::errc::invalid_argument ||
+                (result.ptr != last && *result.ptr != ';' && *result.ptr != ' ' && *result.ptr != '\t')) {
+                return fail(400, "Malformed chunk size");
+            }
+            if (result.ec == std::errc::result_out_of_range || size > limits.maxBodySize - chunkedBody.size()) {
+                return fail(413, "Request body too large");
+            }
+            cursor = lineEnd + 2;
+            bodyLength = size;
+            stage = size == 0 ? Stage::TRAILERS : Stage::CHUNK_DATA;
+            break;
+        }
+        case Stage::CHUNK_DATA: {
+            std::size_t available = std::min(bodyLength, input.size() - cursor);
+            chunkedBody.append(input.data() + cursor, available);
+            cursor += available;
+            bodyLength -= available;
+            if (bodyLength > 0) {
+                return Status::INCOMPLETE;
+            }
+            stage = Stage::CHUNK_END;
+            break;
+        }
+        case Stage::CHUNK_END:
+            if (input.size() < cursor + 2) {
+                return Status::INCOMPLETE;
+            }
+            if (input[cursor] != '\r' || input[cursor + 1] != '\n') {
+                return fail(400, "Malformed chunk");
+            }
+            cursor += 2;
+            stage = Stage::CHUNK_SIZE;
+            break;
+        case Stage::TRAILERS: {
+            // Trailer fields are skipped; they count against the head size limit
+            std::size_t lineEnd = input.find("\r\n", cursor);
+            if (lineEnd == std::string_view::npos) {
+                if (trailerBytes + (input.size() - cursor) > limits.maxHeadSize) {
+                    return fail(431, "Request trailers too large");
+                }
+                return Status::INCOMPLETE;
+            }
+            if (lineEnd == cursor) {
+                return complete(input, cursor + 2);
+            }
+            trailerBytes += lineEnd + 2 - cursor;
+            if (trailerBytes > limits.maxHeadSize) {
+                return fail(431, "Request trailers too large");
+            }
+            cursor = lineEnd + 2;
+            break;
+        }
+        default:
+            return Status::INCOMPLETE;
+        }
+    }
+}
+
+HttpRequestParser::Status HttpRequestParser::complete(std::string_view input, std::size_t end) {
+    auto view = [input](Span span) { return input.substr(span.offset, span.length); };
+    parsed.method = view(method);
+    parsed.target = view(target);
+    parsed.version = view(version);
+    std::size_t queryStart = parsed.target.find('?');
+    parsed.path = parsed.target.substr(0, queryStart);
+    parsed.query = queryStart == std::string_view::npos ? std::string_view() : parsed.target.substr(queryStart + 1);
+    parsed.headers.clear();
+    for (const auto& field : headerSpans) {
+        parsed.headers.emplace_back(view(field.first), view(field.second));
+    }
+    parsed.body = chunked ? std::string_view(chunkedBody) : view(fixedBody);
+    consumedBytes = end;
+    stage = Stage::DONE;
+    return Status::COMPLETE;
+}
+
+std::string_view HttpRequestParser::queryParam(std::string_view query, std::string_view name, bool* found) {
+    if (found) {
+        *found = false;
+    }
+    while (!query.empty()) {
+        std::size_t end = query.find('&');
+        std::string_view pair = query.substr(0, end);
+        std::size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == name) {
+            if (found) {
+                *found = true;
+            }
+            return eq == std::string_view::npos ? std::string_view() : pair.substr(eq + 1);
+        }
+        if (end == std::string_view::npos) {
+            break;
+        }
+        query.remove_prefix(end + 1);
+    }
+    return {};
+}
+
+std::string HttpRequestParser::urlDecode(std::string_view value) {
+    std::string decoded;
+    decoded.reserve(value.size());
+    for (std::size_t i = 0; i < value.size(); ++i) {
+        int high = 0;
+        int low = 0;
+        if (value[i] == '+') {
+            decoded += ' ';
+        } else if (value[i] == '%' && i + 2 < value.size() && (high = hexValue(value[i + 1])) >= 0 &&
+                   (low = hexValue(value[i + 2])) >= 0) {
+            decoded += static_cast<char>(high * 16 + low);
+            i += 2;
+        } else {
+            decoded += value[i];
+        }
+    }
+    return decoded;
+}
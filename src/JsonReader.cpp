@@ -0,0 +1,380 @@
+#include "JsonReader.h"
+#include <charconv>
+#include <climits>
+#include <stdexcept>
+
+namespace {
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+void appendUtf8(std::string& out, unsigned codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xc0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xe0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (codePoint & 0x3f));
+    } else {
+        out += static_cast<char>(0xf0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f));
+        out += static_cast<char>(0x80 | (codePoint & 0x3f));
+    }
+}
+
+} // namespace
+
+void JsonReader::fail(const char* what) const {
+    throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos) + ": " + what);
+}
+
+void JsonReader::skipWhitespace() {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t')) {
+        ++pos;
+    }
+}
+
+void JsonReader::expect(char c) {
+    skipWhitespace();
+    if (pos >= text.size() || text[pos] != c) {
+        char message[] = "expected ' '";
+        message[10] = c;
+        fail(message);
+    }
+    ++pos;
+}
+
+void JsonReader::enter() {
+    if (depth == MAX_DEPTH) {
+        fail("nested too deeply");
+    }
+    first[++depth] = true;
+}
+
+// Consumes `close` (leaving the level) and returns false, or the ',' before any
+// element but the first and returns true
+bool JsonReader::separator(char close) {
+    skipWhitespace();
+    if (pos < text.size() && text[pos] == close) {
+        ++pos;
+        --depth;
+        return false;
+    }
+    if (first[depth]) {
+        first[depth] = false;
+    } else {
+        expect(',');
+    }
+    return true;
+}
+
+JsonReader::Type JsonReader::peek() {
+    skipWhitespace();
+    if (pos >= text.size()) {
+        fail("unexpected end of input");
+    }
+    switch (text[pos]) {
+    case '{': return Type::OBJECT;
+    case '[': return Type::ARRAY;
+    case '"': return Type::STRING;
+    case 't':
+    case 'f': return Type::BOOLEAN;
+    case 'n': return Type::NULL_VALUE;
+    default:
+        if (text[pos] == '-' || isDigit(text[pos])) {
+            return Type::NUMBER;
+        }
+        fail("unexpected character");
+    }
+}
+
+void JsonReader::beginObject() {
+    expect('{');
+    enter();
+}
+
+bool JsonReader::nextMember(std::string_view& key) {
+    if (!separator('}')) {
+        return false;
+    }
+    skipWhitespace();
+    if (pos >= text.size() || text[pos] != '"') {
+        fail("expected a member name");
+    }
+    key = parseString(keyScratch);
+    expect(':');
+    return true;
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+    enter();
+}
+
+bool JsonReader::nextElement() {
+    return separator(']');
+}
+
+std::string_view JsonReader::string() {
+    if (peek() != Type::STRING) {
+        fail("expected a string");
+    }
+    return parseString(valueScratch);
+}
+
+// Parses the string starting at the opening quote. Returns a view of the input when
+// there is nothing to decode, otherwise decodes into `scratch`.
+std::string_view JsonReader::parseString(std::string& scratch) {
+    std::size_t start = ++pos;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '"') {
+            return text.substr(start, pos++ - start);
+        }
+        if (c == '\\') {
+            break;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("control character in string");
+        }
+        ++pos;
+    }
+
+    scratch.assign(text.data() + start, pos - start);
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '"') {
+            ++pos;
+            return scratch;
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("control character in string");
+        }
+        if (c != '\\') {
+            // Copy the run up to the next quote or escape in one go
+            std::size_t runEnd = pos + 1;
+            while (runEnd < text.size() && text[runEnd] != '"' && text[runEnd] != '\\' &&
+                   static_cast<unsigned char>(text[runEnd]) >= 0x20) {
+                ++runEnd;
+            }
+            scratch.append(text.data() + pos, runEnd - pos);
+            pos = runEnd;
+            continue;
+        }
+        if (++pos >= text.size()) {
+            break;
+        }
+        switch (text[pos++]) {
+        case '"': scratch += '"'; break;
+        case '\\': scratch += '\\'; break;
+        case '/': scratch += '/'; break;
+        case 'b': scratch += '\b'; break;
+        case 'f': scratch += '\f'; break;
+        case 'n': scratch += '\n'; break;
+        case 'r': scratch += '\r'; break;
+        case 't': scratch += '\t'; break;
+        case 'u': {
+            unsigned codePoint = parseHex4();
+            if (codePoint >= 0xdc00 && codePoint <= 0xdfff) {
+                fail("unpaired surrogate");
+            }
+            if (codePoint >= 0xd800 && codePoint <= 0xdbff) {
+                if (text.substr(pos, 2) != "\\u") {
+                    fail("unpaired surrogate");
+                }
+                pos += 2;
+                unsigned low = parseHex4();
+                if (low < 0xdc00 || low > 0xdfff) {
+                    fail("unpaired surrogate");
+                }
+                codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (low - 0xdc00);
+            }
+            appendUtf8(scratch, codePoint);
+            break;
+        }
+        default:
+            --pos;
+            fail("invalid escape");
+        }
+    }
+    fail("unterminated string");
+}
+
+unsigned JsonReader::parseHex4() {
+    if (text.size() - pos < 4) {
+        fail("invalid \\u escape");
+    }
+    unsigned value = 0;
+    for (int i = 0; i < 4; ++i) {
+        int digit = hexValue(text[pos + i]);
+        if (digit < 0) {
+            fail("invalid \\u escape");
+        }
+        value = value * 16 + static_cast<unsigned>(digit);
+    }
+    pos += 4;
+    return value;
+}
+
+// Validates -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)? and returns its text
+std::string_view JsonReader::parseNumber(bool& integral) {
+    skipWhitespace();
+    std::size_t start = pos;
+    auto digits = [this] {
+        std::size_t from = pos;
+        while (pos < text.size() && isDigit(text[pos])) {
+            ++pos;
+        }
+        return pos - from;
+    };
+    if (pos < text.size() && text[pos] == '-') {
+        ++pos;
+    }
+    if (pos < text.size() && text[pos] == '0') {
+        ++pos;
+    } else if (digits() == 0) {
+        fail("expected a number");
+    }
+    integral = true;
+    if (pos < text.size() && text[pos] == '.') {
+        ++pos;
+        integral = false;
+        if (digits() == 0) {
+            fail("expected digits after '.'");
+        }
+    }
+    if (pos < text.size() && (text[pos] == 'e' || text[pos] == 'E')) {
+        ++pos;
+        integral = false;
+        if (pos < text.size() && (text[pos] == '+' || text[pos] == '-')) {
+            ++pos;
+        }
+        if (digits() == 0) {
+            fail("expected an exponent");
+        }
+    }
+    return text.substr(start, pos - start);
+}
+
+long long JsonReader::integer() {
+    if (peek() != Type::NUMBER) {
+        fail("expected an integer");
+    }
+    std::size_t start = pos;
+    bool integral = false;
+    std::string_view number = parseNumber(integral);
+    long long value = 0;
+    auto result = std::from_chars(number.data(), number.data() + number.size(), value);
+    if (!integral || result.ec != std::errc()) {
+        pos = start;
+        fail(integral ? "integer out of range" : "expected an integer");
+    }
+    return value;
+}
+
+void JsonReader::literal(std::string_view word) {
+    if (text.substr(pos, word.size()) != word) {
+        fail("invalid literal");
+    }
+    pos += word.size();
+}
+
+bool JsonReader::boolean() {
+    if (peek() != Type::BOOLEAN) {
+        fail("expected true or false");
+    }
+    bool value = text[pos] == 't';
+    literal(value ? "true" : "false");
+    return value;
+}
+
+bool JsonReader::null() {
+    if (peek() != Type::NULL_VALUE) {
+        return false;
+    }
+    literal("null");
+    return true;
+}
+
+void JsonReader::skipValue() {
+    switch (peek()) {
+    case Type::OBJECT: {
+        beginObject();
+        std::string_view key;
+        while (nextMember(key)) {
+            skipValue();
+        }
+        break;
+    }
+    case Type::ARRAY:
+        beginArray();
+        while (nextElement()) {
+            skipValue();
+        }
+        break;
+    case Type::STRING:
+        parseString(valueScratch);
+        break;
+    case Type::NUMBER: {
+        bool integral = false;
+        parseNumber(integral);
+        break;
+    }
+    case Type::BOOLEAN:
+        boolean();
+        break;
+    case Type::NULL_VALUE:
+        null();
+        break;
+    }
+}
+
+void JsonReader::end() {
+    skipWhitespace();
+    if (pos != text.size()) {
+        fail("unexpected data after the value");
+    }
+}
+
+bool JsonReader::task(Task& task) {
+    bool hasHeader = false;
+    bool hasDifficulty = false;
+    task.description.clear();
+    task.dueDate.clear();
+
+    beginObject();
+    std::string_view key;
+    while (nextMember(key)) {
+        if (key == "header") {
+            task.header.assign(string());
+            hasHeader = true;
+        } else if (key == "description") {
+            if (!null()) {
+                task.description.assign(string());
+            }
+        } else if (key == "difficulty") {
+            long long difficulty = integer();
+            task.difficulty = difficulty >= INT_MIN && difficulty <= INT_MAX ? static_cast<int>(difficulty) : 0;
+            hasDifficulty = true;
+        } else if (key == "dueDate") {
+            if (!null()) {
+                task.dueDate.assign(string());
+            }
+        } else {
+            skipValue();
+        }
+    }
+    return hasHeader && hasDifficulty;
+}
@@ -0,0 +1,157 @@
+#include "JsonWriter.h"
+#include <array>
+#include <charconv>
+#include <cmath>
+
+namespace {
+
+// true for the bytes that must be written as \u00XX
+constexpr std::array<bool, 256> makeEscapeTable() {
+    std::array<bool, 256> table{};
+    for (int c = 0; c < 0x20; ++c) {
+        table[c] = true;
+    }
+    table['"'] = true;
+    table['\\'] = true;
+    return table;
+}
+
+constexpr std::array<bool, 256> NEEDS_ESCAPE = makeEscapeTable();
+
+template <typename Integer>
+void appendInteger(std::string& out, Integer number) {
+    char digits[24];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+}
+
+} // namespace
+
+void JsonWriter::appendEscaped(std::string& out, std::string_view text) {
+    static const char hexDigits[] = "0123456789abcdef";
+    const char* data = text.data();
+    std::size_t runStart = 0;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (!NEEDS_ESCAPE[c]) {
+            continue;
+        }
+        // Copy the clean run before this byte in one go
+        out.append(data + runStart, i - runStart);
+        char escaped[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0xf]};
+        out.append(escaped, sizeof(escaped));
+        runStart = i + 1;
+    }
+    out.append(data + runStart, text.size() - runStart);
+}
+
+void JsonWriter::separate() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (needsComma) {
+        out += ',';
+    }
+    needsComma = true;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    separate();
+    out += '{';
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endObject() {
+    out += '}';
+    needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    separate();
+    out += '[';
+    needsComma = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::endArray() {
+    out += ']';
+    needsComma = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    out += '"';
+    appendEscaped(out, name);
+    out += "\":";
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    out += '"';
+    appendEscaped(out, text);
+    out += '"';
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(long long number) {
+    separate();
+    appendInteger(out, number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(unsigned long long number) {
+    separate();
+    appendInteger(out, number);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    separate();
+    if (!std::isfinite(number)) {
+        out += "null";
+        return *this;
+    }
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), number);
+    out.append(digits, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out += flag ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    separate();
+    out += "null";
+    return *this;
+}
+
+JsonWriter& JsonWriter::task(const TaskView& task) {
+    // Keys are fixed, so write them as literals instead of going through key()
+    separate();
+    out += "{\"id\":";
+    appendInteger(out, task.id);
+    out += ",\"header\":\"";
+    appendEscaped(out, task.header);
+    out += "\",\"description\":\"";
+    appendEscaped(out, task.description);
+    out += task.completed ? "\",\"completed\":true,\"difficulty\":" : "\",\"completed\":false,\"difficulty\":";
+    appendInteger(out, task.difficulty);
+    out += ",\"dueDate\":\"";
+    appendEscaped(out, task.dueDate);
+    out += "\"}";
+    return *this;
+}
+
+JsonWriter& JsonWriter::task(const Task& task) {
+    return this->task(TaskView{task.id, task.header, task.description, task.completed, task.difficulty, task.dueDate, task.dueDay});
+}
@@ -0,0 +1,112 @@
+#include "PriorityIndex.h"
+#include "DueDate.h"
+#include <algorithm>
+
+TaskPrioritizer::SortKey PriorityIndex::keyOf(Strategy strategy, const Task& task, int day) {
+    return TaskPrioritizer(strategy).keyFor(task, static_cast<std::uint32_t>(task.id), day);
+}
+
+void PriorityIndex::load(std::vector<Task> openTasks) {
+    clear();
+    tasks.reserve(openTasks.size());
+    for (auto& task : openTasks) {
+        int id = task.id;
+        tasks.emplace(id, std::move(task));
+    }
+    loaded = true;
+}
+
+void PriorityIndex::clear() {
+    loaded = false;
+    tasks.clear();
+    for (auto& ordering : orderings) {
+        ordering = Ordering();
+    }
+}
+
+void PriorityIndex::upsert(const Task& task) {
+    if (!loaded) {
+        return;
+    }
+    remove(task.id);
+    
+    auto inserted = tasks.emplace(task.id, task).first;
+    for (std::size_t s = 0; s < orderings.size(); ++s) {
+        Ordering& ordering = orderings[s];
+        if (ordering.built) {
+            ordering.keys.insert(keyOf(static_cast<Strategy>(s), inserted->second, ordering.day));
+        }
+    }
+}
+
+void PriorityIndex::remove(int id) {
+    auto it = tasks.find(id);
+    if (it == tasks.end()) {
+        return;
+    }
+    
+    // Keys are recomputed from the stored copy with the day each ordering was built for
+    for (std::size_t s = 0; s < orderings.size(); ++s) {
+        Ordering& ordering = orderings[s];
+        if (ordering.built) {
+            ordering.keys.erase(keyOf(static_cast<Strategy>(s), it->second, ordering.day));
+        }
+    }
+    tasks.erase(it);
+}
+
+void PriorityIndex::build(Strategy strategy, int today) {
+    Ordering& ordering = orderings[static_cast<std::size_t>(strategy)];
+    ordering.keys.clear();
+    for (const auto& entry : tasks) {
+        ordering.keys.insert(keyOf(strategy, entry.second, today));
+    }
+    ordering.day = today;
+    ordering.built = true;
+}
+
+std::vector<Task> PriorityIndex::top(Strategy strategy, std::size_t limit) {
+    if (strategy == Strategy::WEIGHTED) {
+        return rank(TaskPrioritizer(strategy), limit);
+    }
+    Ordering& ordering = orderings[static_cast<std::size_t>(strategy)];
+    int today = currentEpochDay();
+    
+    // Only BALANCED keys change with the date
+    if (!ordering.built || (strategy == Strategy::BALANCED && ordering.day != today)) {
+        build(strategy, today);
+    }
+    
+    std::size_t count = (limit == 0 || limit > ordering.keys.size()) ? ordering.keys.size() : limit;
+    std::vector<Task> result;
+    result.reserve(count);
+    for (auto it = ordering.keys.begin(); result.size() < count; ++it) {
+        result.push_back(tasks.at(static_cast<int>(it->index)));
+    }
+    return result;
+}
+
+std::vector<Task> PriorityIndex::top(const TaskPrioritizer& prioritizer, std::size_t limit) {
+    if (prioritizer.getStrategy() == Strategy::WEIGHTED) {
+        return rank(prioritizer, limit);
+    }
+    return top(prioritizer.getStrategy(), limit);
+}
+
+std::vector<Task> PriorityIndex::rank(const TaskPrioritizer& prioritizer, std::size_t limit) const {
+    int today = currentEpochDay();
+    std::vector<TaskPrioritizer::SortKey> keys;
+    keys.reserve(tasks.size());
+    for (const auto& entry : tasks) {
+        keys.push_back(prioritizer.keyFor(entry.second, static_cast<std::uint32_t>(entry.first), today));
+    }
+    
+    std::size_t count = (limit == 0 || limit > keys.size()) ? keys.size() : limit;
+    std::partial_sort(keys.begin(), keys.begin() + count, keys.end());
+    std::vector<Task> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        result.push_back(tasks.at(static_cast<int>(keys[i].index)));
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#include "ResponseCache.h"
+#include <atomic>
+
+ResponseCache::ResponseCache(std::size_t slotCount) : slots(slotCount) {}
+
+ResponseCache::Bytes ResponseCache::get(std::size_t slot, std::uint64_t version, std::string_view variant) const {
+    std::shared_ptr<const Entry> entry = std::atomic_load(&slots.at(slot));
+    if (!entry || entry->version != version || entry->variant != variant) {
+        return nullptr;
+    }
+    // Aliasing pointer: shares ownership of the entry, points at its bytes
+    return Bytes(entry, &entry->bytes);
+}
+
+ResponseCache::Bytes ResponseCache::put(std::size_t slot, std::uint64_t version, std::string variant, std::string bytes) {
+    auto entry = std::make_shared<const Entry>(Entry{version, std::move(variant), std::move(bytes)});
+    std::shared_ptr<const Entry>& target = slots.at(slot);
+    std::shared_ptr<const Entry> current = std::atomic_load(&target);
+    while (!current || current->version <= version) {
+        if (std::atomic_compare_exchange_strong(&target, &current, entry)) {
+            break;
+        }
+    }
+    return Bytes(entry, &entry->bytes);
+}
+
+void ResponseCache::clear() {
+    for (auto& slot : slots) {
+        std::atomic_store(&slot, std::shared_ptr<const Entry>());
+    }
+}
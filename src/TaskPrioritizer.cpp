@@ -1,111 +1,391 @@
 #include "TaskPrioritizer.h"
+#include "DueDate.h"
 #include <algorithm>
-#include <ctime>
-#include <iomanip>
-#include <sstream>
+#include <cfloat>
+#include <cmath>
 #include <limits>  // For std::numeric_limits
+#include <stdexcept>
+#include <thread>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define TODO_HAVE_AVX2_KERNEL 1
+#endif
 
 TaskPrioritizer::TaskPrioritizer(Strategy strategy) : currentStrategy(strategy) {}
 
+TaskPrioritizer::TaskPrioritizer(Weights weights) : currentStrategy(Strategy::WEIGHTED) {
+    setWeights(weights);
+}
+
 void TaskPrioritizer::setStrategy(Strategy strategy) {
     currentStrategy = strategy;
 }
 
-void TaskPrioritizer::prioritizeTasks(std::vector<Task>& tasks) {
-    // Apply the chosen strategy
-    switch (currentStrategy) {
-        case Strategy::DUE_DATE_FIRST:
-            sortByDueDate(tasks);
-            break;
-        case Strategy::DIFFICULTY_FIRST:
-            sortByDifficulty(tasks);
-            break;
+void TaskPrioritizer::setWeights(Weights weights) {
+    if (!std::isfinite(weights.dueDate) || !std::isfinite(weights.difficulty) ||
+        weights.dueDate < 0 || weights.difficulty < 0) {
+        throw std::runtime_error("Strategy weights must be finite and non-negative");
+    }
+    currentWeights = weights;
+}
+
+const std::vector<TaskPrioritizer::Strategy>& TaskPrioritizer::allStrategies() {
+    static const std::vector<Strategy> strategies = {
+        Strategy::DUE_DATE_FIRST, Strategy::DIFFICULTY_FIRST, Strategy::BALANCED, Strategy::WEIGHTED
+    };
+    return strategies;
+}
+
+const char* TaskPrioritizer::strategyName(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::DUE_DATE_FIRST: return "due_date_first";
+        case Strategy::DIFFICULTY_FIRST: return "difficulty_first";
+        case Strategy::WEIGHTED: return "weighted";
         case Strategy::BALANCED:
-        default:
-            sortBalanced(tasks);
-            break;
+        default: return "balanced";
+    }
+}
+
+const char* TaskPrioritizer::strategyTitle(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::DUE_DATE_FIRST: return "Due Date First";
+        case Strategy::DIFFICULTY_FIRST: return "Difficulty First";
+        case Strategy::WEIGHTED: return "Weighted";
+        case Strategy::BALANCED:
+        default: return "Balanced";
     }
 }
 
-// Helper function to convert date string to time_t for comparison
-time_t stringToDate(const std::string& dateStr) {
-    // If date is empty, return a very future date
-    if (dateStr.empty()) {
-        return std::numeric_limits<time_t>::max();
+const char* TaskPrioritizer::strategyDescription(Strategy strategy) {
+    switch (strategy) {
+        case Strategy::DUE_DATE_FIRST: return "Prioritize tasks by due date, then by difficulty";
+        case Strategy::DIFFICULTY_FIRST: return "Prioritize easier tasks first, then by due date";
+        case Strategy::WEIGHTED: return "Score dueWeight * days until due - difficultyWeight * difficulty, lowest first";
+        case Strategy::BALANCED:
+        default: return "Use a weighted algorithm considering both due date and difficulty";
+    }
+}
+
+std::optional<TaskPrioritizer::Strategy> TaskPrioritizer::strategyFromName(const std::string& name) {
+    for (Strategy strategy : allStrategies()) {
+        if (name == strategyName(strategy)) {
+            return strategy;
+        }
+    }
+    return std::nullopt;
+}
+
+TaskPrioritizer TaskPrioritizer::fromParameters(const std::string& name, const std::string& dueWeight,
+                                                const std::string& difficultyWeight) {
+    TaskPrioritizer prioritizer;
+    if (!name.empty()) {
+        auto strategy = strategyFromName(name);
+        if (!strategy) {
+            throw std::invalid_argument("Unknown strategy: " + name);
+        }
+        prioritizer.setStrategy(*strategy);
+    }
+    if (dueWeight.empty() && difficultyWeight.empty()) {
+        return prioritizer;
+    }
+    if (prioritizer.getStrategy() != Strategy::WEIGHTED) {
+        throw std::invalid_argument("dueWeight and difficultyWeight require strategy=weighted");
     }
     
-    std::tm tm = {};
-    std::istringstream ss(dateStr);
-    ss >> std::get_time(&tm, "%Y-%m-%d");
+    // A weight string must be a number in full (no trailing characters)
+    auto parseWeight = [](const std::string& text, double& weight) {
+        if (text.empty()) {
+            return true;
+        }
+        try {
+            std::size_t used = 0;
+            weight = std::stod(text, &used);
+            return used == text.size();
+        } catch (const std::exception&) {
+            return false;
+        }
+    };
+    Weights weights;
+    try {
+        if (!parseWeight(dueWeight, weights.dueDate) || !parseWeight(difficultyWeight, weights.difficulty)) {
+            throw std::runtime_error("malformed weight");
+        }
+        prioritizer.setWeights(weights);
+    } catch (const std::runtime_error&) {
+        throw std::invalid_argument("dueWeight and difficultyWeight must be non-negative numbers");
+    }
+    return prioritizer;
+}
+
+void TaskPrioritizer::setParallelism(unsigned threads, std::size_t threshold) {
+    parallelThreads = threads;
+    parallelThreshold = threshold;
+}
+
+void TaskPrioritizer::prioritizeTasks(std::vector<Task>& tasks) const {
+    unsigned threads = parallelThreads == 0 ? std::thread::hardware_concurrency() : parallelThreads;
+    if (threads > 1 && tasks.size() >= parallelThreshold) {
+        prioritizeParallel(tasks, threads);
+        return;
+    }
     
-    // If date parsing failed, return a very future date
-    if (ss.fail()) {
-        return std::numeric_limits<time_t>::max();
+    // Decorate, sort the keys, then undecorate
+    std::vector<SortKey> keys = computeKeys(tasks);
+    std::sort(keys.begin(), keys.end());
+    applyOrder(tasks, keys);
+}
+
+void TaskPrioritizer::prioritizeTopK(std::vector<Task>& tasks, std::size_t k) const {
+    if (k >= tasks.size()) {
+        prioritizeTasks(tasks);
+        return;
     }
     
-    return std::mktime(&tm);
+    std::vector<SortKey> keys = computeKeys(tasks);
+    std::partial_sort(keys.begin(), keys.begin() + k, keys.end());
+    keys.resize(k);
+    applyOrder(tasks, keys);
 }
 
-void TaskPrioritizer::sortByDueDate(std::vector<Task>& tasks) const {
-    std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
-        // First compare by due date
-        time_t dateA = stringToDate(a.dueDate);
-        time_t dateB = stringToDate(b.dueDate);
-        
-        if (dateA != dateB) {
-            return dateA < dateB;  // Earlier date first
-        }
-        
-        // If dates are the same, sort by difficulty (higher first)
-        return a.difficulty > b.difficulty;
-    });
+// Due date as an epoch day: the stored integer when the task was read from the
+// database, otherwise parsed from the string (NO_DUE_DAY when missing or malformed)
+static int dueDayOf(const Task& task) {
+    return task.dueDay != NO_DUE_DAY ? task.dueDay : epochDayFromDate(task.dueDate);
 }
 
-void TaskPrioritizer::sortByDifficulty(std::vector<Task>& tasks) const {
-    std::sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
-        // First compare by difficulty
-        if (a.difficulty != b.difficulty) {
-            return a.difficulty < b.difficulty;  // Easier tasks first
-        }
-        
-        // If difficulties are equal, sort by due date
-        time_t dateA = stringToDate(a.dueDate);
-        time_t dateB = stringToDate(b.dueDate);
-        return dateA < dateB;  // Earlier date first
+// Key policies: one type per strategy, so the per-task key extraction is
+// resolved at compile time instead of switching on the strategy per task
+struct DueDateFirstPolicy {
+    TaskPrioritizer::SortKey operator()(const Task& task, std::uint32_t index) const {
+        // Earlier date first, then higher difficulty first
+        return {static_cast<double>(dueDayOf(task)), -task.difficulty, index};
+    }
+};
+
+struct DifficultyFirstPolicy {
+    TaskPrioritizer::SortKey operator()(const Task& task, std::uint32_t index) const {
+        // Easier tasks first, then earlier date first
+        return {static_cast<double>(task.difficulty), dueDayOf(task), index};
+    }
+};
+
+struct BalancedPolicy {
+    int today;
+    
+    TaskPrioritizer::SortKey operator()(const Task& task, std::uint32_t index) const {
+        return {TaskPrioritizer::balancedScore(dueDayOf(task), task.difficulty, today), 0, index};
+    }
+};
+
+struct WeightedPolicy {
+    TaskPrioritizer::Weights weights;
+    int today;
+    
+    TaskPrioritizer::SortKey operator()(const Task& task, std::uint32_t index) const {
+        int dueDay = dueDayOf(task);
+        // Undated tasks last, hardest first among them
+        int secondary = dueDay == NO_DUE_DAY ? -task.difficulty : 0;
+        return {TaskPrioritizer::weightedScore(dueDay, task.difficulty, today, weights), secondary, index};
+    }
+};
+
+// Calls fn with the policy object of the given strategy
+template <typename Fn>
+static auto withPolicy(TaskPrioritizer::Strategy strategy, TaskPrioritizer::Weights weights, int today, Fn&& fn) {
+    switch (strategy) {
+        case TaskPrioritizer::Strategy::DUE_DATE_FIRST:
+            return fn(DueDateFirstPolicy{});
+        case TaskPrioritizer::Strategy::DIFFICULTY_FIRST:
+            return fn(DifficultyFirstPolicy{});
+        case TaskPrioritizer::Strategy::WEIGHTED:
+            return fn(WeightedPolicy{weights, today});
+        case TaskPrioritizer::Strategy::BALANCED:
+        default:
+            return fn(BalancedPolicy{today});
+    }
+}
+
+template <typename Policy>
+static void fillKeys(const std::vector<Task>& tasks, std::size_t begin, std::size_t end,
+                     const Policy& policy, TaskPrioritizer::SortKey* keys) {
+    for (std::size_t i = begin; i < end; ++i) {
+        keys[i] = policy(tasks[i], static_cast<std::uint32_t>(i));
+    }
+}
+
+TaskPrioritizer::SortKey TaskPrioritizer::keyFor(const Task& task, std::uint32_t index, int today) const {
+    return withPolicy(currentStrategy, currentWeights, today, [&](const auto& policy) {
+        return policy(task, index);
     });
 }
 
-void TaskPrioritizer::sortBalanced(std::vector<Task>& tasks) const {
-    // Get current time
-    time_t now = std::time(nullptr);
+float TaskPrioritizer::balancedScore(int dueDay, int difficulty, int today) {
+    // Priority score (lower is higher priority): days_until_due / difficulty
+    // - Tasks with closer due dates get higher priority
+    // - More difficult tasks get higher priority
+    // - Past-due tasks count as due today
+    // - If a task has no due date, it gets lowest priority
+    if (dueDay == NO_DUE_DAY) {
+        return FLT_MAX;
+    }
+    return static_cast<float>(std::max(0, dueDay - today)) / static_cast<float>(difficulty);
+}
+
+double TaskPrioritizer::weightedScore(int dueDay, int difficulty, int today, Weights weights) {
+    if (dueDay == NO_DUE_DAY) {
+        return DBL_MAX;
+    }
+    return weights.dueDate * std::max(0, dueDay - today) - weights.difficulty * difficulty;
+}
+
+static void scoreBalancedScalar(const TaskPrioritizer::TaskBatch& batch, int today, float* scores) {
+    for (std::size_t i = 0; i < batch.size; ++i) {
+        scores[i] = TaskPrioritizer::balancedScore(batch.dueDays[i], batch.difficulties[i], today);
+    }
+}
+
+#ifdef TODO_HAVE_AVX2_KERNEL
+// Eight tasks per iteration; the same int->float conversion and IEEE division as
+// balancedScore, so results match the scalar loop bit for bit
+__attribute__((target("avx2")))
+static void scoreBalancedAvx2(const TaskPrioritizer::TaskBatch& batch, int today, float* scores) {
+    const __m256i todayVec = _mm256_set1_epi32(today);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i noDueDay = _mm256_set1_epi32(NO_DUE_DAY);
+    const __m256 maxScore = _mm256_set1_ps(FLT_MAX);
     
-    std::sort(tasks.begin(), tasks.end(), [now](const Task& a, const Task& b) {
-        time_t dateA = stringToDate(a.dueDate);
-        time_t dateB = stringToDate(b.dueDate);
-        
-        // Calculate days until due date
-        double daysA = std::difftime(dateA, now) / (60 * 60 * 24);
-        double daysB = std::difftime(dateB, now) / (60 * 60 * 24);
-        
-        // If a task is past due, give it highest priority
-        if (daysA < 0) daysA = 0;
-        if (daysB < 0) daysB = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= batch.size; i += 8) {
+        __m256i due = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.dueDays + i));
+        __m256i difficulty = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(batch.difficulties + i));
         
-        // Calculate priority score (lower is higher priority)
-        // Formula: days_until_due / difficulty
-        // This means:
-        // - Tasks with closer due dates get higher priority
-        // - More difficult tasks get higher priority
-        // - If a task has no due date, it gets lowest priority
-        
-        double scoreA = (dateA == std::numeric_limits<time_t>::max()) ? 
-                        std::numeric_limits<double>::max() : 
-                        daysA / a.difficulty;
-                        
-        double scoreB = (dateB == std::numeric_limits<time_t>::max()) ? 
-                        std::numeric_limits<double>::max() : 
-                        daysB / b.difficulty;
-        
-        return scoreA < scoreB;  // Lower score (higher priority) first
+        // NO_DUE_DAY lanes wrap around here, but they are replaced by the blend below
+        __m256i days = _mm256_max_epi32(_mm256_sub_epi32(due, todayVec), zero);
+        __m256 score = _mm256_div_ps(_mm256_cvtepi32_ps(days), _mm256_cvtepi32_ps(difficulty));
+        __m256 undated = _mm256_castsi256_ps(_mm256_cmpeq_epi32(due, noDueDay));
+        _mm256_storeu_ps(scores + i, _mm256_blendv_ps(score, maxScore, undated));
+    }
+    
+    // Tail
+    TaskPrioritizer::TaskBatch rest = {batch.dueDays + i, batch.difficulties + i, batch.size - i};
+    scoreBalancedScalar(rest, today, scores + i);
+}
+#endif
+
+void TaskPrioritizer::scoreBalanced(const TaskBatch& batch, int today, float* scores) {
+#ifdef TODO_HAVE_AVX2_KERNEL
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (hasAvx2) {
+        scoreBalancedAvx2(batch, today, scores);
+        return;
+    }
+#endif
+    scoreBalancedScalar(batch, today, scores);
+}
+
+std::vector<TaskPrioritizer::SortKey> TaskPrioritizer::computeKeys(const std::vector<Task>& tasks) const {
+    // Read the clock once for the whole batch
+    std::vector<SortKey> keys(tasks.size());
+    computeKeys(tasks, 0, tasks.size(), currentEpochDay(), keys.data());
+    return keys;
+}
+
+void TaskPrioritizer::computeKeys(const std::vector<Task>& tasks, std::size_t begin, std::size_t end, int today, SortKey* keys) const {
+    if (currentStrategy != Strategy::BALANCED) {
+        withPolicy(currentStrategy, currentWeights, today, [&](const auto& policy) {
+            fillKeys(tasks, begin, end, policy, keys);
+        });
+        return;
+    }
+    
+    // BALANCED: gather a structure-of-arrays batch and score it with the vector kernel
+    std::size_t count = end - begin;
+    std::vector<std::int32_t> dueDays(count);
+    std::vector<std::int32_t> difficulties(count);
+    std::vector<float> scores(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        dueDays[i] = dueDayOf(tasks[begin + i]);
+        difficulties[i] = tasks[begin + i].difficulty;
+    }
+    scoreBalanced({dueDays.data(), difficulties.data(), count}, today, scores.data());
+    for (std::size_t i = 0; i < count; ++i) {
+        keys[begin + i] = {scores[i], 0, static_cast<std::uint32_t>(begin + i)};
+    }
+}
+
+void TaskPrioritizer::applyOrder(std::vector<Task>& tasks, const std::vector<SortKey>& keys) {
+    // Moving a Task only swaps string buffers, so this is one linear pass.
+    // Tasks without a key (top-k selection) are dropped.
+    std::vector<Task> ordered;
+    ordered.reserve(keys.size());
+    for (const auto& key : keys) {
+        ordered.push_back(std::move(tasks[key.index]));
+    }
+    tasks.swap(ordered);
+}
+
+// Runs fn(begin, end) over `chunks` contiguous slices of [0, count), one thread per slice
+template <typename Fn>
+static void parallelChunks(std::size_t count, std::size_t chunks, Fn fn) {
+    std::vector<std::thread> workers;
+    workers.reserve(chunks);
+    for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t begin = count * c / chunks;
+        std::size_t end = count * (c + 1) / chunks;
+        workers.emplace_back([&fn, begin, end] { fn(begin, end); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void TaskPrioritizer::prioritizeParallel(std::vector<Task>& tasks, unsigned threads) const {
+    const std::size_t n = tasks.size();
+    const std::size_t chunks = std::min<std::size_t>(threads, n);
+    const int today = currentEpochDay();
+    
+    // 1. Compute keys and sort each chunk independently
+    std::vector<SortKey> keys(n);
+    parallelChunks(n, chunks, [&](std::size_t begin, std::size_t end) {
+        computeKeys(tasks, begin, end, today, keys.data());
+        std::sort(keys.begin() + begin, keys.begin() + end);
+    });
+    
+    // 2. Merge neighbouring sorted runs pairwise, ping-ponging between two buffers
+    std::vector<std::size_t> bounds;
+    for (std::size_t c = 0; c <= chunks; ++c) {
+        bounds.push_back(n * c / chunks);
+    }
+    std::vector<SortKey> scratch(n);
+    while (bounds.size() > 2) {
+        std::vector<std::size_t> merged;
+        std::vector<std::thread> workers;
+        for (std::size_t r = 0; r + 1 < bounds.size(); r += 2) {
+            std::size_t begin = bounds[r];
+            std::size_t mid = bounds[r + 1];
+            std::size_t end = r + 2 < bounds.size() ? bounds[r + 2] : mid;  // Odd run out is copied as-is
+            merged.push_back(begin);
+            workers.emplace_back([&keys, &scratch, begin, mid, end] {
+                std::merge(keys.begin() + begin, keys.begin() + mid,
+                           keys.begin() + mid, keys.begin() + end,
+                           scratch.begin() + begin);
+            });
+        }
+        merged.push_back(n);
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        keys.swap(scratch);
+        bounds.swap(merged);
+    }
+    
+    // 3. Move tasks into key order, each thread filling its own slice of the output
+    std::vector<Task> ordered(n);
+    parallelChunks(n, chunks, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ordered[i] = std::move(tasks[keys[i].index]);
+        }
     });
-}
\ No newline at end of file
+    tasks.swap(ordered);
+}
@@ -1,23 +1,171 @@
 #include "ToDoList.h"
 #include "TaskPrioritizer.h"
+#include "DueDate.h"
 #include <stdexcept>
+#include <algorithm>
 #include <iostream>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
 
-ToDoList::ToDoList() : db(nullptr, sqlite3_close) {}
+ToDoList::ToDoList() {
+    std::random_device random;
+    dataVersionSalt = (static_cast<std::uint64_t>(random()) << 32) ^ random() ^
+                      static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+ToDoList::~ToDoList() {
+    setGroupCommit({});  // Flushes and stops the committer thread
+}
+
+// NO_DUE_DAY spelled out for SQL text
+#define NO_DUE_DAY_SQL "2147483647"
+static_assert(NO_DUE_DAY == 2147483647, "NO_DUE_DAY_SQL must match NO_DUE_DAY");
+
+// Schema history, applied in order and tracked with PRAGMA user_version.
+// Append new steps at the end; never edit a step that has already shipped.
+struct Migration {
+    int version;
+    const char* sql;
+};
+
+static const Migration migrations[] = {
+    // 1: base table (IF NOT EXISTS so databases created before versioning are adopted as-is)
+    {1,
+     "CREATE TABLE IF NOT EXISTS tasks ("
+     "id INTEGER PRIMARY KEY AUTOINCREMENT,"
+     "header TEXT NOT NULL,"
+     "description TEXT,"
+     "completed INTEGER DEFAULT 0,"
+     "difficulty INTEGER CHECK(difficulty BETWEEN 1 AND 5),"
+     "dueDate TEXT"
+     ");"},
+    // 2: secondary indexes for the open/completed list filters and due-date range scans.
+    // The rowid is implicitly part of every index, so idx_tasks_completed already yields
+    // rows in id order for "WHERE completed = ? ORDER BY id".
+    {2,
+     "CREATE INDEX IF NOT EXISTS idx_tasks_completed ON tasks(completed);"
+     "CREATE INDEX IF NOT EXISTS idx_tasks_completed_due ON tasks(completed, dueDate);"},
+    // 3: integer epoch-day copy of dueDate (see DueDate.h), kept in sync by addTask/editTask.
+    // Rows without a valid date get NO_DUE_DAY so they sort last; the index moves to the integer.
+    {3,
+     "ALTER TABLE tasks ADD COLUMN dueDay INTEGER;"
+     "UPDATE tasks SET dueDay = CASE "
+     "WHEN dueDate GLOB '[0-9][0-9][0-9][0-9]-[0-9][0-9]-[0-9][0-9]' AND julianday(dueDate) IS NOT NULL "
+     "THEN CAST(julianday(dueDate) - 2440587.5 AS INTEGER) "
+     "ELSE " NO_DUE_DAY_SQL " END;"
+     "DROP INDEX IF EXISTS idx_tasks_completed_due;"
+     "CREATE INDEX IF NOT EXISTS idx_tasks_completed_due_day ON tasks(completed, dueDay);"},
+    // 4: indexes matching the ORDER BY of the SQL prioritization engine, so open tasks
+    // stream in DUE_DATE_FIRST / DIFFICULTY_FIRST order (id comes last via the rowid)
+    // without a sort. The first also serves the dueDay range filters and replaces
+    // idx_tasks_completed_due_day.
+    {4,
+     "CREATE INDEX IF NOT EXISTS idx_tasks_completed_due_first ON tasks(completed, dueDay, difficulty DESC);"
+     "CREATE INDEX IF NOT EXISTS idx_tasks_completed_difficulty ON tasks(completed, difficulty, dueDay);"
+     "DROP INDEX IF EXISTS idx_tasks_completed_due_day;"},
+    // 5: FTS5 index over header and description for searchTasks. External content
+    // (the text lives only in tasks); triggers keep it in sync and 'rebuild' backfills
+    // existing rows. Prefix indexes make the search-as-you-type last token cheap.
+    {5,
+     "CREATE VIRTUAL TABLE IF NOT EXISTS tasks_fts USING fts5("
+     "header, description, content='tasks', content_rowid='id', "
+     "tokenize='unicode61 remove_diacritics 2', prefix='2 3');"
+     "CREATE TRIGGER IF NOT EXISTS tasks_fts_insert AFTER INSERT ON tasks BEGIN "
+     "INSERT INTO tasks_fts(rowid, header, description) VALUES (new.id, new.header, new.description); "
+     "END;"
+     "CREATE TRIGGER IF NOT EXISTS tasks_fts_delete AFTER DELETE ON tasks BEGIN "
+     "INSERT INTO tasks_fts(tasks_fts, rowid, header, description) VALUES ('delete', old.id, old.header, old.description); "
+     "END;"
+     "CREATE TRIGGER IF NOT EXISTS tasks_fts_update AFTER UPDATE OF header, description ON tasks BEGIN "
+     "INSERT INTO tasks_fts(tasks_fts, rowid, header, description) VALUES ('delete', old.id, old.header, old.description); "
+     "INSERT INTO tasks_fts(rowid, header, description) VALUES (new.id, new.header, new.description); "
+     "END;"
+     "INSERT INTO tasks_fts(tasks_fts) VALUES ('rebuild');"},
+};
+
+// Runs one or more SQL statements, turning failures into exceptions
+static void execOrThrow(sqlite3* db, const std::string& sql, const std::string& context) {
+    char* errorMsg = nullptr;
+    if (sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errorMsg) != SQLITE_OK) {
+        std::string error = context + ": ";
+        error += errorMsg ? errorMsg : sqlite3_errmsg(db);
+        sqlite3_free(errorMsg);
+        throw std::runtime_error(error);
+    }
+}
+
+// Copies the current row of a task-selecting statement into a Task
+static Task readTaskRow(sqlite3_stmt* stmt) {
+    return viewTaskRow(stmt).toTask();
+}
 
-void ToDoList::prepareStatements() {
+// ORDER BY of the SQL prioritization engine, indexed by TaskPrioritizer::Strategy.
+// Each matches the TaskPrioritizer key of that strategy, ending in id like the
+// index tie-break. Parameters: ?1 limit, ?2 today, ?3/?4 WEIGHTED weights.
+static const char* const PRIORITY_ORDER_BY[] = {
+    // DUE_DATE_FIRST (idx_tasks_completed_due_first)
+    "dueDay, difficulty DESC, id",
+    // DIFFICULTY_FIRST (idx_tasks_completed_difficulty)
+    "difficulty, dueDay, id",
+    // BALANCED and WEIGHTED depend on today's date and cannot be indexed; SQLite
+    // keeps only the first LIMIT rows while sorting
+    "balanced_score(dueDay, difficulty, ?2), id",
+    "weighted_score(dueDay, difficulty, ?2, ?3, ?4), "
+    "CASE WHEN dueDay = " NO_DUE_DAY_SQL " THEN -difficulty ELSE 0 END, id",
+};
+
+// balanced_score(dueDay, difficulty, today): TaskPrioritizer::balancedScore
+static void balancedScoreSql(sqlite3_context* context, int, sqlite3_value** args) {
+    for (int i = 0; i < 3; ++i) {
+        if (sqlite3_value_type(args[i]) == SQLITE_NULL) {
+            sqlite3_result_null(context);
+            return;
+        }
+    }
+    sqlite3_result_double(context, TaskPrioritizer::balancedScore(
+        sqlite3_value_int(args[0]), sqlite3_value_int(args[1]), sqlite3_value_int(args[2])));
+}
+
+// weighted_score(dueDay, difficulty, today, dueWeight, difficultyWeight): TaskPrioritizer::weightedScore
+static void weightedScoreSql(sqlite3_context* context, int, sqlite3_value** args) {
+    for (int i = 0; i < 5; ++i) {
+        if (sqlite3_value_type(args[i]) == SQLITE_NULL) {
+            sqlite3_result_null(context);
+            return;
+        }
+    }
+    TaskPrioritizer::Weights weights = {sqlite3_value_double(args[3]), sqlite3_value_double(args[4])};
+    sqlite3_result_double(context, TaskPrioritizer::weightedScore(
+        sqlite3_value_int(args[0]), sqlite3_value_int(args[1]), sqlite3_value_int(args[2]), weights));
+}
+
+// Registers the scoring functions used by PRIORITY_ORDER_BY on one connection
+static void registerScoreFunctions(sqlite3* db) {
+    int flags = SQLITE_UTF8 | SQLITE_DETERMINISTIC;
+#ifdef SQLITE_INNOCUOUS
+    flags |= SQLITE_INNOCUOUS;
+#endif
+    if (sqlite3_create_function_v2(db, "balanced_score", 3, flags, nullptr, balancedScoreSql, nullptr, nullptr, nullptr) != SQLITE_OK ||
+        sqlite3_create_function_v2(db, "weighted_score", 5, flags, nullptr, weightedScoreSql, nullptr, nullptr, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(std::string("Failed to register SQL functions: ") + sqlite3_errmsg(db));
+    }
+}
+
+void ToDoList::Connection::prepareStatements() {
     sqlite3_stmt* raw_stmt;
     
     // Add task
     if (sqlite3_prepare_v2(db.get(), 
-        "INSERT INTO tasks (header, description, completed, difficulty, dueDate) VALUES (?, ?, ?, ?, ?)",
+        "INSERT INTO tasks (header, description, completed, difficulty, dueDate, dueDay) VALUES (?, ?, ?, ?, ?, ?)",
         -1, &raw_stmt, nullptr) == SQLITE_OK) {
         addTaskStmt.reset(raw_stmt);
     }
     
     // Prepare get tasks statement - now including dueDate
     if (sqlite3_prepare_v2(db.get(), 
-        "SELECT id, header, description, completed, difficulty, dueDate FROM tasks WHERE completed = 0",
+        "SELECT id, header, description, completed, difficulty, dueDate, dueDay FROM tasks WHERE completed = 0 ORDER BY id",
         -1, &raw_stmt, nullptr) == SQLITE_OK) {
         getTasksStmt.reset(raw_stmt);
     }
@@ -31,7 +179,7 @@ void ToDoList::prepareStatements() {
     
     // Edit task
     if (sqlite3_prepare_v2(db.get(), 
-        "UPDATE tasks SET header = ?, description = ?, difficulty = ?, dueDate = ? WHERE id = ?",
+        "UPDATE tasks SET header = ?, description = ?, difficulty = ?, dueDate = ?, dueDay = ? WHERE id = ?",
         -1, &raw_stmt, nullptr) == SQLITE_OK) {
         editTaskStmt.reset(raw_stmt);
     }
@@ -52,157 +200,836 @@ void ToDoList::prepareStatements() {
 
     // Get completed tasks - now including dueDate
     if (sqlite3_prepare_v2(db.get(), 
-        "SELECT id, header, description, completed, difficulty, dueDate FROM tasks WHERE completed = 1",
+        "SELECT id, header, description, completed, difficulty, dueDate, dueDay FROM tasks WHERE completed = 1 ORDER BY id",
         -1, &raw_stmt, nullptr) == SQLITE_OK) {
         getCompletedTasksStmt.reset(raw_stmt);
     }
+
+    // Get a single task by primary key
+    if (sqlite3_prepare_v2(db.get(), 
+        "SELECT id, header, description, completed, difficulty, dueDate, dueDay FROM tasks WHERE id = ?",
+        -1, &raw_stmt, nullptr) == SQLITE_OK) {
+        getTaskByIdStmt.reset(raw_stmt);
+    }
+
+    // One page of tasks after a cursor; unset filters are bound as NULL
+    if (sqlite3_prepare_v2(db.get(), 
+        "SELECT id, header, description, completed, difficulty, dueDate, dueDay FROM tasks "
+        "WHERE completed = ?1 AND id > ?2 "
+        "AND (?3 IS NULL OR difficulty = ?3) "
+        "AND (?4 IS NULL OR dueDay >= ?4) "
+        "AND (?5 IS NULL OR dueDay <= ?5) "
+        "AND ((?4 IS NULL AND ?5 IS NULL) OR dueDay < " NO_DUE_DAY_SQL ") "
+        "ORDER BY id LIMIT ?6",
+        -1, &raw_stmt, nullptr) == SQLITE_OK) {
+        getTasksPageStmt.reset(raw_stmt);
+    }
+
+    // Full-text search, best BM25 match first (header matches weigh double)
+    if (sqlite3_prepare_v2(db.get(), 
+        "SELECT t.id, t.header, t.description, t.completed, t.difficulty, t.dueDate, t.dueDay "
+        "FROM tasks_fts JOIN tasks t ON t.id = tasks_fts.rowid "
+        "WHERE tasks_fts MATCH ?1 ORDER BY bm25(tasks_fts, 2.0, 1.0), t.id LIMIT ?2",
+        -1, &raw_stmt, nullptr) == SQLITE_OK) {
+        searchTasksStmt.reset(raw_stmt);
+    }
+
+    // Every header, to load the suggestion index
+    if (sqlite3_prepare_v2(db.get(), 
+        "SELECT id, header FROM tasks",
+        -1, &raw_stmt, nullptr) == SQLITE_OK) {
+        getHeadersStmt.reset(raw_stmt);
+    }
+
+    // Open tasks in priority order, one statement per strategy
+    for (std::size_t i = 0; i < prioritizedStmts.size(); ++i) {
+        std::string sql = "SELECT id, header, description, completed, difficulty, dueDate, dueDay FROM tasks "
+                          "WHERE completed = 0 ORDER BY ";
+        sql += PRIORITY_ORDER_BY[i];
+        sql += " LIMIT ?1";
+        if (sqlite3_prepare_v2(db.get(), sql.c_str(), -1, &raw_stmt, nullptr) == SQLITE_OK) {
+            prioritizedStmts[i].reset(raw_stmt);
+        }
+    }
 }
 
-void ToDoList::connect(const std::string& dbPath) {
-    sqlite3* raw_db;
-    if (sqlite3_open(dbPath.c_str(), &raw_db) != SQLITE_OK) {
-        throw std::runtime_error(std::string("Failed to open database: ") + sqlite3_errmsg(raw_db));
+void ToDoList::runMigrations() {
+    sqlite3_stmt* raw_stmt;
+    int currentVersion = 0;
+    if (sqlite3_prepare_v2(writer->db.get(), "PRAGMA user_version", -1, &raw_stmt, nullptr) != SQLITE_OK) {
+        throw std::runtime_error(std::string("Failed to read schema version: ") + sqlite3_errmsg(writer->db.get()));
+    }
+    if (sqlite3_step(raw_stmt) == SQLITE_ROW) {
+        currentVersion = sqlite3_column_int(raw_stmt, 0);
     }
-    db.reset(raw_db); // smart pointer takes ownership of raw_db
+    sqlite3_finalize(raw_stmt);
     
-    // Create tasks table if it doesn't exist
-    const char* createTableSQL = 
-        "CREATE TABLE IF NOT EXISTS tasks ("
-        "id INTEGER PRIMARY KEY AUTOINCREMENT,"
-        "header TEXT NOT NULL,"
-        "description TEXT,"
-        "completed INTEGER DEFAULT 0,"
-        "difficulty INTEGER CHECK(difficulty BETWEEN 1 AND 5),"
-        "dueDate TEXT"
-        ");";
+    // Each step and its version bump commit together, so an interrupted
+    // upgrade resumes from the last completed step
+    for (const auto& migration : migrations) {
+        if (migration.version <= currentVersion) {
+            continue;
+        }
         
-    char* errorMsg = nullptr;
-    if (sqlite3_exec(db.get(), createTableSQL, nullptr, nullptr, &errorMsg) != SQLITE_OK) {
-        std::string error = "Failed to create table: ";
-        error += errorMsg;
-        sqlite3_free(errorMsg);
+        execOrThrow(writer->db.get(), "BEGIN IMMEDIATE", "Failed to start migration");
+        try {
+            execOrThrow(writer->db.get(), migration.sql,
+                        "Failed to apply migration " + std::to_string(migration.version));
+            execOrThrow(writer->db.get(), "PRAGMA user_version = " + std::to_string(migration.version),
+                        "Failed to record schema version");
+            execOrThrow(writer->db.get(), "COMMIT", "Failed to commit migration");
+        } catch (...) {
+            sqlite3_exec(writer->db.get(), "ROLLBACK", nullptr, nullptr, nullptr);
+            throw;
+        }
+        currentVersion = migration.version;
+    }
+}
+
+std::unique_ptr<ToDoList::Connection> ToDoList::openConnection(bool readOnly) const {
+    int flags = SQLITE_OPEN_NOMUTEX | (readOnly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE));
+    
+    sqlite3* raw_db = nullptr;
+    if (sqlite3_open_v2(dbPath.c_str(), &raw_db, flags, nullptr) != SQLITE_OK) {
+        std::string error = std::string("Failed to open database: ") + (raw_db ? sqlite3_errmsg(raw_db) : "out of memory");
+        sqlite3_close(raw_db);
         throw std::runtime_error(error);
     }
     
-    prepareStatements();
+    auto conn = std::make_unique<Connection>();
+    conn->db.reset(raw_db); // smart pointer takes ownership of raw_db
+    
+    // Wait for the writer instead of failing immediately while a checkpoint or migration runs
+    sqlite3_busy_timeout(raw_db, 5000);
+    registerScoreFunctions(raw_db);
+    return conn;
+}
+
+void ToDoList::connect(const std::string& path) {
+    dbPath = path;
+    sharedCache = (path == ":memory:" || path.empty());
+    
+    std::lock_guard<std::mutex> writeLock(writerMutex);
+    std::lock_guard<std::mutex> readLock(readersMutex);
+    idleReaders.clear();
+    writer = openConnection(false);
+    
+    // WAL lets the pooled readers run concurrently with the writer.
+    // The journal mode is persistent, so this only does work the first time.
+    if (!sharedCache) {
+        execOrThrow(writer->db.get(), "PRAGMA journal_mode=WAL", "Failed to enable WAL mode");
+    }
+    
+    runMigrations();
+    writer->prepareStatements();
+    bumpDataVersion();
+}
+
+std::string ToDoList::getDataVersionTag() const {
+    char tag[48];
+    std::snprintf(tag, sizeof(tag), "%016llx-%llu", static_cast<unsigned long long>(dataVersionSalt),
+                  static_cast<unsigned long long>(getDataVersion()));
+    return tag;
+}
+
+ToDoList::ReadLease::ReadLease(const ToDoList& owner) : owner(owner) {
+    if (!owner.writer) {
+        throw std::runtime_error("Database is not connected");
+    }
+    
+    if (owner.sharedCache) {
+        writerLock = std::unique_lock<std::mutex>(owner.writerMutex);
+        conn = owner.writer.get();
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(owner.readersMutex);
+        if (!owner.idleReaders.empty()) {
+            pooled = std::move(owner.idleReaders.back());
+            owner.idleReaders.pop_back();
+        }
+    }
+    
+    // Open outside the pool lock; a new thread only pays this once
+    if (!pooled) {
+        pooled = owner.openConnection(true);
+        pooled->prepareStatements();
+    }
+    conn = pooled.get();
+}
+
+ToDoList::ReadLease::~ReadLease() {
+    if (pooled) {
+        std::lock_guard<std::mutex> lock(owner.readersMutex);
+        owner.idleReaders.push_back(std::move(pooled));
+    }
 }
 
-void ToDoList::addTask(const std::string& header, const std::string& description, int difficulty, const std::string& dueDate) {
-    sqlite3_reset(addTaskStmt.get());
-    sqlite3_bind_text(addTaskStmt.get(), 1, header.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(addTaskStmt.get(), 2, description.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(addTaskStmt.get(), 3, 0);  // not completed
-    sqlite3_bind_int(addTaskStmt.get(), 4, difficulty);
-    sqlite3_bind_text(addTaskStmt.get(), 5, dueDate.c_str(), -1, SQLITE_STATIC);
+// Binds and runs the cached INSERT once, returning the new row id
+static int insertTask(sqlite3* db, sqlite3_stmt* stmt, const std::string& header, const std::string& description, int difficulty, const std::string& dueDate) {
+    sqlite3_reset(stmt);
+    sqlite3_bind_text(stmt, 1, header.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_text(stmt, 2, description.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 3, 0);  // not completed
+    sqlite3_bind_int(stmt, 4, difficulty);
+    sqlite3_bind_text(stmt, 5, dueDate.c_str(), -1, SQLITE_STATIC);
+    sqlite3_bind_int(stmt, 6, epochDayFromDate(dueDate));
     
-    if (sqlite3_step(addTaskStmt.get()) != SQLITE_DONE) {
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+        sqlite3_reset(stmt);  // Leave nothing pending on the writer for the rollback
         throw std::runtime_error("Failed to insert task");
     }
+    return static_cast<int>(sqlite3_last_insert_rowid(db));
+}
+
+int ToDoList::addTask(const std::string& header, const std::string& description, int difficulty, const std::string& dueDate) {
+    int id = 0;
+    write([&] {
+        id = insertTask(writer->db.get(), writer->addTaskStmt.get(), header, description, difficulty, dueDate);
+    }, [&] {
+        Task added = {id, header, description, false, difficulty, dueDate, epochDayFromDate(dueDate)};
+        indexTasks({added});
+        suggestTaskHeaders({added});
+    });
+    return id;
+}
+
+std::vector<int> ToDoList::addTasks(const std::vector<Task>& tasks) {
+    std::vector<int> ids;
+    ids.reserve(tasks.size());
+    
+    // One transaction (and one fsync) for the whole batch instead of one per row
+    write([&] {
+        for (const auto& task : tasks) {
+            ids.push_back(insertTask(writer->db.get(), writer->addTaskStmt.get(), task.header, task.description, task.difficulty, task.dueDate));
+        }
+    }, [&] {
+        std::vector<Task> added;
+        added.reserve(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const Task& task = tasks[i];
+            added.push_back({ids[i], task.header, task.description, false, task.difficulty, task.dueDate, epochDayFromDate(task.dueDate)});
+        }
+        indexTasks(added);
+        suggestTaskHeaders(added);
+    }, true);
+    
+    return ids;
 }
 
 void ToDoList::deleteTask(int id) {
-    sqlite3_reset(deleteTaskStmt.get());
-    sqlite3_bind_int(deleteTaskStmt.get(), 1, id);
-    if (sqlite3_step(deleteTaskStmt.get()) != SQLITE_DONE) {
-        throw std::runtime_error("Failed to delete task");
-    }
+    write([&] {
+        sqlite3_stmt* stmt = writer->deleteTaskStmt.get();
+        sqlite3_reset(stmt);
+        StatementReset reset{stmt};
+        sqlite3_bind_int(stmt, 1, id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw std::runtime_error("Failed to delete task");
+        }
+    }, [&] {
+        unindexTask(id);
+        unsuggestTask(id);
+    });
 }
 
 void ToDoList::editTask(int id, const std::string& header, const std::string& description, int difficulty, const std::string& dueDate) {
-    sqlite3_reset(editTaskStmt.get());
-    sqlite3_bind_text(editTaskStmt.get(), 1, header.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_text(editTaskStmt.get(), 2, description.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(editTaskStmt.get(), 3, difficulty);
-    sqlite3_bind_text(editTaskStmt.get(), 4, dueDate.c_str(), -1, SQLITE_STATIC);
-    sqlite3_bind_int(editTaskStmt.get(), 5, id);
+    bool changed = false;
+    write([&] {
+        sqlite3_stmt* stmt = writer->editTaskStmt.get();
+        sqlite3_reset(stmt);
+        StatementReset reset{stmt};
+        sqlite3_bind_text(stmt, 1, header.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_text(stmt, 2, description.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 3, difficulty);
+        sqlite3_bind_text(stmt, 4, dueDate.c_str(), -1, SQLITE_STATIC);
+        sqlite3_bind_int(stmt, 5, epochDayFromDate(dueDate));
+        sqlite3_bind_int(stmt, 6, id);
+        
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw std::runtime_error("Failed to edit task");
+        }
+        changed = sqlite3_changes(writer->db.get()) > 0;
+    }, [&] {
+        refreshIndexedTask(id);
+        if (changed) {
+            suggestTaskHeader(id, header);
+        }
+    });
+}
 
-    if (sqlite3_step(editTaskStmt.get()) != SQLITE_DONE) {
-        throw std::runtime_error("Failed to edit task");
+void ToDoList::checkScanDone(int rc, sqlite3* db, const char* what) {
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string(what) + ": " + sqlite3_errmsg(db));
     }
 }
 
 std::vector<Task> ToDoList::getTasks() const {
-    sqlite3_reset(getTasksStmt.get());
+    ReadLease reader(*this);
+    sqlite3_stmt* stmt = reader->getTasksStmt.get();
+    
+    sqlite3_reset(stmt);
+    StatementReset reset{stmt};
     std::vector<Task> tasks;
     
-    while (sqlite3_step(getTasksStmt.get()) == SQLITE_ROW) {
-        Task task;
-        task.id = sqlite3_column_int(getTasksStmt.get(), 0);
-        
-        // Handle text columns safely by checking for null
-        const char* headerText = reinterpret_cast<const char*>(sqlite3_column_text(getTasksStmt.get(), 1));
-        task.header = headerText ? std::string(headerText) : "";
-        
-        const char* descText = reinterpret_cast<const char*>(sqlite3_column_text(getTasksStmt.get(), 2));
-        task.description = descText ? std::string(descText) : "";
-        
-        task.completed = sqlite3_column_int(getTasksStmt.get(), 3) != 0;
-        task.difficulty = sqlite3_column_int(getTasksStmt.get(), 4);
-        
-        const char* dateText = reinterpret_cast<const char*>(sqlite3_column_text(getTasksStmt.get(), 5));
-        task.dueDate = dateText ? std::string(dateText) : "";
-        
-        tasks.push_back(task);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        tasks.push_back(readTaskRow(stmt));
     }
+    checkScanDone(rc, reader->db.get(), "Failed to read tasks");
     
     return tasks;
 }
 
-bool ToDoList::markTaskAsCompleted(int id) {
-    sqlite3_reset(markCompletedStmt.get());
-    sqlite3_bind_int(markCompletedStmt.get(), 1, id);
+// Runs the by-id statement for a single key
+static std::optional<Task> lookupTask(sqlite3_stmt* stmt, int id) {
+    sqlite3_reset(stmt);
+    sqlite3_bind_int(stmt, 1, id);
     
-    if (sqlite3_step(markCompletedStmt.get()) != SQLITE_DONE) {
-        throw std::runtime_error("Failed to mark task as completed");
+    int rc = sqlite3_step(stmt);
+    if (rc == SQLITE_ROW) {
+        Task task = readTaskRow(stmt);
+        sqlite3_reset(stmt);
+        return task;
+    }
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error("Failed to look up task");
+    }
+    return std::nullopt;
+}
+
+std::optional<Task> ToDoList::getTaskById(int id) const {
+    ReadLease reader(*this);
+    return lookupTask(reader->getTaskByIdStmt.get(), id);
+}
+
+void ToDoList::indexTasks(const std::vector<Task>& tasks) {
+    std::lock_guard<std::mutex> lock(priorityMutex);
+    ++indexGeneration;
+    for (const auto& task : tasks) {
+        if (task.completed) {
+            priorityIndex.remove(task.id);
+        } else {
+            priorityIndex.upsert(task);
+        }
+    }
+}
+
+void ToDoList::unindexTask(int id) {
+    std::lock_guard<std::mutex> lock(priorityMutex);
+    ++indexGeneration;
+    priorityIndex.remove(id);
+}
+
+void ToDoList::suggestTaskHeaders(const std::vector<Task>& tasks) {
+    std::lock_guard<std::mutex> lock(suggestMutex);
+    ++suggestGeneration;
+    for (const auto& task : tasks) {
+        headerSuggester.upsert(task.id, task.header);
+    }
+}
+
+void ToDoList::suggestTaskHeader(int id, const std::string& header) {
+    std::lock_guard<std::mutex> lock(suggestMutex);
+    ++suggestGeneration;
+    headerSuggester.upsert(id, header);
+}
+
+void ToDoList::unsuggestTask(int id) {
+    std::lock_guard<std::mutex> lock(suggestMutex);
+    ++suggestGeneration;
+    headerSuggester.remove(id);
+}
+
+std::vector<HeaderSuggester::Suggestion> ToDoList::suggestHeaders(const std::string& prefix, std::size_t limit) const {
+    unsigned long long generation;
+    {
+        std::lock_guard<std::mutex> lock(suggestMutex);
+        if (headerSuggester.isLoaded()) {
+            return headerSuggester.suggest(prefix, limit);
+        }
+        generation = suggestGeneration;
+    }
+    
+    // First call: read the headers without holding the index lock
+    std::vector<std::pair<int, std::string>> headers;
+    {
+        ReadLease reader(*this);
+        sqlite3_stmt* stmt = reader->getHeadersStmt.get();
+        sqlite3_reset(stmt);
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            const char* header = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+            headers.emplace_back(sqlite3_column_int(stmt, 0), header ? header : "");
+        }
+        sqlite3_reset(stmt);
+    }
+    
+    std::lock_guard<std::mutex> lock(suggestMutex);
+    if (!headerSuggester.isLoaded() && generation == suggestGeneration) {
+        headerSuggester.load(headers);
+    }
+    if (headerSuggester.isLoaded()) {
+        return headerSuggester.suggest(prefix, limit);
     }
     
-    return sqlite3_changes(db.get()) > 0;
+    // A write landed while reading; answer from the snapshot and let the next call load
+    HeaderSuggester snapshot;
+    snapshot.load(headers);
+    return snapshot.suggest(prefix, limit);
 }
 
-bool ToDoList::unmarkTaskAsCompleted(int id) {
-    sqlite3_reset(unmarkCompletedStmt.get());
-    sqlite3_bind_int(unmarkCompletedStmt.get(), 1, id);
+void ToDoList::refreshIndexedTask(int id) {
+    auto task = lookupTask(writer->getTaskByIdStmt.get(), id);
+    if (task) {
+        indexTasks({*task});
+    } else {
+        unindexTask(id);
+    }
+}
 
-    if (sqlite3_step(unmarkCompletedStmt.get()) != SQLITE_DONE) {
-        throw std::runtime_error("Failed to unmark task as completed");
+std::vector<Task> ToDoList::getTasksByIds(const std::vector<int>& ids) const {
+    ReadLease reader(*this);
+    std::vector<Task> tasks;
+    tasks.reserve(ids.size());
+    
+    // One indexed point lookup per id, reusing the cached statement
+    for (int id : ids) {
+        if (auto task = lookupTask(reader->getTaskByIdStmt.get(), id)) {
+            tasks.push_back(std::move(*task));
+        }
     }
+    
+    return tasks;
+}
 
-    return sqlite3_changes(db.get()) > 0;
+bool ToDoList::markTaskAsCompleted(int id) {
+    bool changed = false;
+    write([&] {
+        sqlite3_stmt* stmt = writer->markCompletedStmt.get();
+        sqlite3_reset(stmt);
+        StatementReset reset{stmt};
+        sqlite3_bind_int(stmt, 1, id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw std::runtime_error("Failed to mark task as completed");
+        }
+        changed = sqlite3_changes(writer->db.get()) > 0;
+    }, [&] {
+        if (changed) {
+            unindexTask(id);
+        }
+    });
+    return changed;
+}
+
+bool ToDoList::unmarkTaskAsCompleted(int id) {
+    bool changed = false;
+    write([&] {
+        sqlite3_stmt* stmt = writer->unmarkCompletedStmt.get();
+        sqlite3_reset(stmt);
+        StatementReset reset{stmt};
+        sqlite3_bind_int(stmt, 1, id);
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            throw std::runtime_error("Failed to unmark task as completed");
+        }
+        changed = sqlite3_changes(writer->db.get()) > 0;
+    }, [&] {
+        if (changed) {
+            refreshIndexedTask(id);
+        }
+    });
+    return changed;
 }
 
 std::vector<Task> ToDoList::getCompletedTasks() const {
-    sqlite3_reset(getCompletedTasksStmt.get());
+    ReadLease reader(*this);
+    sqlite3_stmt* stmt = reader->getCompletedTasksStmt.get();
+    
+    sqlite3_reset(stmt);
+    StatementReset reset{stmt};
     std::vector<Task> tasks;
     
-    while (sqlite3_step(getCompletedTasksStmt.get()) == SQLITE_ROW) {
-        Task task;
-        task.id = sqlite3_column_int(getCompletedTasksStmt.get(), 0);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        tasks.push_back(readTaskRow(stmt));
+    }
+    checkScanDone(rc, reader->db.get(), "Failed to read tasks");
+    
+    return tasks;
+}
+
+TaskPage ToDoList::getTasksPage(const TaskQuery& query) const {
+    int limit = std::max(1, std::min(query.limit, TaskQuery::maxLimit));
+    
+    ReadLease reader(*this);
+    sqlite3_stmt* stmt = reader->getTasksPageStmt.get();
+    
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    sqlite3_bind_int(stmt, 1, query.completed ? 1 : 0);
+    sqlite3_bind_int(stmt, 2, query.afterId);
+    if (query.difficulty) {
+        sqlite3_bind_int(stmt, 3, *query.difficulty);
+    }
+    if (!query.dueFrom.empty()) {
+        sqlite3_bind_int(stmt, 4, epochDayFromDate(query.dueFrom));
+    }
+    if (!query.dueTo.empty()) {
+        sqlite3_bind_int(stmt, 5, epochDayFromDate(query.dueTo));
+    }
+    // Fetch one extra row to learn whether another page follows
+    sqlite3_bind_int(stmt, 6, limit + 1);
+    
+    TaskPage page;
+    page.tasks.reserve(limit);
+    while (sqlite3_step(stmt) == SQLITE_ROW) {
+        if (static_cast<int>(page.tasks.size()) == limit) {
+            page.nextCursor = page.tasks.back().id;
+            break;
+        }
+        page.tasks.push_back(readTaskRow(stmt));
+    }
+    sqlite3_reset(stmt);
+    
+    return page;
+}
+
+std::vector<Task> ToDoList::getPrioritizedTasks(std::size_t limit) const {
+    return getPrioritizedTasks(TaskPrioritizer::Strategy::BALANCED, limit);
+}
+
+std::vector<Task> ToDoList::getPrioritizedTasks(TaskPrioritizer::Strategy strategy, std::size_t limit) const {
+    return getPrioritizedTasks(TaskPrioritizer(strategy), limit);
+}
+
+std::vector<Task> ToDoList::getPrioritizedTasks(const TaskPrioritizer& prioritizer, std::size_t limit) const {
+    if (priorityEngine == PriorityEngine::SQL) {
+        return queryPrioritizedTasks(prioritizer, limit);
+    }
+    
+    unsigned long long generation;
+    {
+        std::lock_guard<std::mutex> lock(priorityMutex);
+        if (priorityIndex.isLoaded()) {
+            return priorityIndex.top(prioritizer, limit);
+        }
+        generation = indexGeneration;
+    }
+    
+    // First prioritized read: scan without holding the index lock so writers are not blocked
+    auto tasks = getTasks();
+    {
+        std::lock_guard<std::mutex> lock(priorityMutex);
+        if (!priorityIndex.isLoaded() && generation == indexGeneration) {
+            priorityIndex.load(tasks);
+        }
+        if (priorityIndex.isLoaded()) {
+            return priorityIndex.top(prioritizer, limit);
+        }
+    }
+    
+    // A write landed while scanning; answer from the snapshot and let the next read load the index
+    if (limit > 0) {
+        prioritizer.prioritizeTopK(tasks, limit);
+    } else {
+        prioritizer.prioritizeTasks(tasks);
+    }
+    
+    return tasks;
+}
+
+// Turns free text into an FTS5 query: every whitespace-separated word becomes a
+// quoted string (so FTS5 operators and punctuation in user input are literal text),
+// all words must match, and the last one also matches as a prefix.
+static std::string ftsQueryFromText(const std::string& text) {
+    std::string query;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        if (std::isspace(static_cast<unsigned char>(text[pos]))) {
+            ++pos;
+            continue;
+        }
+        std::size_t end = pos;
+        while (end < text.size() && !std::isspace(static_cast<unsigned char>(text[end]))) {
+            ++end;
+        }
         
-        const char* headerText = reinterpret_cast<const char*>(sqlite3_column_text(getCompletedTasksStmt.get(), 1));
-        task.header = headerText ? std::string(headerText) : "";
+        if (!query.empty()) {
+            query += ' ';
+        }
+        query += '"';
+        for (std::size_t i = pos; i < end; ++i) {
+            if (text[i] == '"') {
+                query += '"';  // Doubled inside a string
+            }
+            query += text[i];
+        }
+        query += '"';
+        pos = end;
+    }
+    
+    if (!query.empty()) {
+        query += '*';
+    }
+    return query;
+}
+
+std::vector<Task> ToDoList::searchTasks(const std::string& text, std::size_t limit) const {
+    std::string query = ftsQueryFromText(text);
+    if (query.empty()) {
+        return {};
+    }
+    
+    ReadLease reader(*this);
+    sqlite3_stmt* stmt = reader->searchTasksStmt.get();
+    
+    sqlite3_reset(stmt);
+    sqlite3_bind_text(stmt, 1, query.c_str(), -1, SQLITE_TRANSIENT);
+    sqlite3_bind_int64(stmt, 2, limit == 0 ? -1 : static_cast<sqlite3_int64>(limit));
+    
+    std::vector<Task> tasks;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        tasks.push_back(readTaskRow(stmt));
+    }
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string("Failed to search tasks: ") + sqlite3_errmsg(reader->db.get()));
+    }
+    
+    return tasks;
+}
+
+void ToDoList::setPriorityEngine(PriorityEngine engine) {
+    priorityEngine = engine;
+    
+    // The SQL engine never reads the index; drop it so mutations stop maintaining it
+    if (engine == PriorityEngine::SQL) {
+        std::lock_guard<std::mutex> lock(priorityMutex);
+        ++indexGeneration;
+        priorityIndex.clear();
+    }
+}
+
+std::vector<Task> ToDoList::queryPrioritizedTasks(const TaskPrioritizer& prioritizer, std::size_t limit) const {
+    ReadLease reader(*this);
+    sqlite3_stmt* stmt = reader->prioritizedStmts[static_cast<std::size_t>(prioritizer.getStrategy())].get();
+    
+    // Statements only declare the parameters their ORDER BY uses; binding the others is a no-op
+    sqlite3_reset(stmt);
+    sqlite3_bind_int64(stmt, 1, limit == 0 ? -1 : static_cast<sqlite3_int64>(limit));
+    sqlite3_bind_int(stmt, 2, currentEpochDay());
+    sqlite3_bind_double(stmt, 3, prioritizer.getWeights().dueDate);
+    sqlite3_bind_double(stmt, 4, prioritizer.getWeights().difficulty);
+    
+    std::vector<Task> tasks;
+    if (limit > 0) {
+        tasks.reserve(limit);
+    }
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        tasks.push_back(readTaskRow(stmt));
+    }
+    sqlite3_reset(stmt);
+    if (rc != SQLITE_DONE) {
+        throw std::runtime_error(std::string("Failed to read prioritized tasks: ") + sqlite3_errmsg(reader->db.get()));
+    }
+    
+    return tasks;
+}
+
+void ToDoList::write(const std::function<void()>& execute, const std::function<void()>& publish, bool atomic) {
+    {
+        std::unique_lock<std::mutex> lock(groupMutex);
+        if (groupCommit.enabled) {
+            // Hand the mutation to the committer and wait for its transaction to commit
+            PendingWrite pending{&execute, &publish, nullptr, false};
+            groupQueue.push_back(&pending);
+            groupReady.notify_all();
+            groupDone.wait(lock, [&pending] { return pending.finished; });
+            if (pending.error) {
+                std::rethrow_exception(pending.error);
+            }
+            return;
+        }
+    }
+    
+    std::lock_guard<std::mutex> lock(writerMutex);
+    if (!writer) {
+        throw std::runtime_error("Database is not connected");
+    }
+    if (!atomic) {
+        execute();
+        publishCommitted(publish);
+        return;
+    }
+    
+    sqlite3* db = writer->db.get();
+    execOrThrow(db, "BEGIN IMMEDIATE", "Failed to start transaction");
+    try {
+        execute();
+        execOrThrow(db, "COMMIT", "Failed to commit transaction");
+    } catch (...) {
+        sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+        throw;
+    }
+    publishCommitted(publish);
+}
+
+void ToDoList::publishCommitted(const std::function<void()>& publish) {
+    try {
+        publish();
+    } catch (...) {
+        dropIndexes();
+        bumpDataVersion();
+        throw;
+    }
+    bumpDataVersion();
+}
+
+void ToDoList::dropIndexes() {
+    {
+        std::lock_guard<std::mutex> lock(priorityMutex);
+        ++indexGeneration;
+        priorityIndex.clear();
+    }
+    std::lock_guard<std::mutex> lock(suggestMutex);
+    ++suggestGeneration;
+    headerSuggester.clear();
+}
+
+GroupCommitOptions GroupCommitOptions::fromEnvironment() {
+    GroupCommitOptions options;
+    if (const char* env = std::getenv("TODO_GROUP_COMMIT_US")) {
+        try {
+            long window = std::stol(env);
+            if (window > 0) {
+                options.enabled = true;
+                options.window = std::chrono::microseconds(window);
+            }
+        } catch (const std::exception&) {
+            std::cerr << "Ignoring invalid TODO_GROUP_COMMIT_US value: " << env << std::endl;
+        }
+    }
+    return options;
+}
+
+void ToDoList::setGroupCommit(const GroupCommitOptions& options) {
+    // Stop the current committer (it drains the queue first), then start a new one
+    {
+        std::lock_guard<std::mutex> lock(groupMutex);
+        groupCommit.enabled = false;
+        groupStopping = true;
+    }
+    groupReady.notify_all();
+    if (groupCommitter.joinable()) {
+        groupCommitter.join();
+    }
+    
+    std::lock_guard<std::mutex> lock(groupMutex);
+    groupStopping = false;
+    groupCommit = options;
+    if (groupCommit.maxBatch == 0) {
+        groupCommit.maxBatch = 1;
+    }
+    if (groupCommit.enabled) {
+        groupCommitter = std::thread([this] { runGroupCommits(); });
+    }
+}
+
+void ToDoList::runGroupCommits() {
+    std::unique_lock<std::mutex> lock(groupMutex);
+    for (;;) {
+        groupReady.wait(lock, [this] { return groupStopping || !groupQueue.empty(); });
+        if (groupQueue.empty()) {
+            return;  // Stopping and drained
+        }
         
-        const char* descText = reinterpret_cast<const char*>(sqlite3_column_text(getCompletedTasksStmt.get(), 2));
-        task.description = descText ? std::string(descText) : "";
+        // Give concurrent writers up to one window to join this batch
+        auto deadline = std::chrono::steady_clock::now() + groupCommit.window;
+        groupReady.wait_until(lock, deadline, [this] {
+            return groupStopping || groupQueue.size() >= groupCommit.maxBatch;
+        });
         
-        task.completed = sqlite3_column_int(getCompletedTasksStmt.get(), 3) != 0;
-        task.difficulty = sqlite3_column_int(getCompletedTasksStmt.get(), 4);
+        std::size_t count = std::min(groupQueue.size(), groupCommit.maxBatch);
+        std::vector<PendingWrite*> batch(groupQueue.begin(), groupQueue.begin() + count);
+        groupQueue.erase(groupQueue.begin(), groupQueue.begin() + count);
         
-        const char* dateText = reinterpret_cast<const char*>(sqlite3_column_text(getCompletedTasksStmt.get(), 5));
-        task.dueDate = dateText ? std::string(dateText) : "";
+        // Whatever happens, every writer in the batch is released with a result
+        lock.unlock();
+        std::exception_ptr batchError;
+        try {
+            commitBatch(batch);
+        } catch (...) {
+            batchError = std::current_exception();
+        }
+        lock.lock();
         
-        tasks.push_back(task);
+        for (PendingWrite* pending : batch) {
+            if (batchError && !pending->error) {
+                pending->error = batchError;
+            }
+            pending->finished = true;
+        }
+        groupDone.notify_all();
     }
-    
-    return tasks;
 }
 
-std::vector<Task> ToDoList::getPrioritizedTasks() const {
-    // Get all tasks
-    auto tasks = getTasks();
+void ToDoList::commitBatch(const std::vector<PendingWrite*>& batch) {
+    std::lock_guard<std::mutex> lock(writerMutex);
+    auto failAll = [&batch](std::exception_ptr error) {
+        for (PendingWrite* pending : batch) {
+            if (!pending->error) {
+                pending->error = error;
+            }
+        }
+    };
+    if (!writer) {
+        failAll(std::make_exception_ptr(std::runtime_error("Database is not connected")));
+        return;
+    }
     
-    // Use TaskPrioritizer to sort them
-    TaskPrioritizer prioritizer;
-    prioritizer.prioritizeTasks(tasks);
+    // One transaction for the batch; a savepoint per mutation, so a failing one is
+    // rolled back on its own and reported to its caller while the others commit
+    sqlite3* db = writer->db.get();
+    try {
+        execOrThrow(db, "BEGIN IMMEDIATE", "Failed to start group commit");
+    } catch (...) {
+        failAll(std::current_exception());
+        return;
+    }
+    for (PendingWrite* pending : batch) {
+        try {
+            execOrThrow(db, "SAVEPOINT write_op", "Failed to start savepoint");
+            try {
+                (*pending->execute)();
+                execOrThrow(db, "RELEASE write_op", "Failed to release savepoint");
+            } catch (...) {
+                pending->error = std::current_exception();
+                sqlite3_exec(db, "ROLLBACK TO write_op; RELEASE write_op", nullptr, nullptr, nullptr);
+            }
+        } catch (...) {
+            pending->error = std::current_exception();
+        }
+    }
     
-    return tasks;
-}
\ No newline at end of file
+    try {
+        execOrThrow(db, "COMMIT", "Failed to commit group commit");
+    } catch (...) {
+        sqlite3_exec(db, "ROLLBACK", nullptr, nullptr, nullptr);
+        failAll(std::current_exception());
+        return;
+    }
+    
+    // Committed: a failing index update is reported to its own caller only
+    for (PendingWrite* pending : batch) {
+        if (!pending->error) {
+            try {
+                (*pending->publish)();
+            } catch (...) {
+                pending->error = std::current_exception();
+                dropIndexes();
+            }
+        }
+    }
+    bumpDataVersion();
+}
@@ -1,11 +1,19 @@
 #include "Task.h"
 #include "TaskPrioritizer.h"
 #include "ToDoList.h"
+#include "DbExecutor.h"
+#include "DueDate.h"
+#include "ETag.h"
+#include "JsonWriter.h"
+#include "ResponseCache.h"
 #include <drogon/drogon.h>
 #include <filesystem>
 #include <string>
 #include <vector>
 #include <ctime>  // For std::time
+#include <cstdlib>
+#include <memory>
+#include <thread>
 
 // Using directives for Drogon types
 using drogon::app;
@@ -20,9 +28,14 @@ using drogon::HttpResponse;
 using drogon::k200OK;
 using drogon::k201Created;
 using drogon::k204NoContent;
+using drogon::k304NotModified;
 using drogon::k400BadRequest;
 using drogon::k404NotFound;
 using drogon::k500InternalServerError;
+using drogon::CT_APPLICATION_JSON;
+using drogon::k503ServiceUnavailable;
+
+using ResponseCallback = std::function<void(const HttpResponsePtr &)>;
 
 // Helper function to convert Task to JSON
 Json::Value taskToJson(const Task &task) {
@@ -36,6 +49,220 @@ Json::Value taskToJson(const Task &task) {
     return json;
 }
 
+// Checks for a YYYY-MM-DD due date, parsed the way ToDoList stores it
+bool isDateParam(const std::string &value) {
+    return epochDayFromDate(value) != NO_DUE_DAY;
+}
+
+// Fills `query` from the pagination/filter parameters of the list endpoints
+// (limit, after_id, difficulty, due_from, due_to). `paged` is left false when
+// none are given, so callers keep returning the full list. Returns an error
+// message for malformed values, or an empty string.
+std::string taskQueryFromRequest(const HttpRequestPtr &req, TaskQuery &query, bool &paged) {
+    const std::string &limit = req->getParameter("limit");
+    const std::string &afterId = req->getParameter("after_id");
+    const std::string &difficulty = req->getParameter("difficulty");
+    query.dueFrom = req->getParameter("due_from");
+    query.dueTo = req->getParameter("due_to");
+
+    paged = !limit.empty() || !afterId.empty() || !difficulty.empty() || !query.dueFrom.empty() || !query.dueTo.empty();
+    try {
+        if (!limit.empty()) {
+            query.limit = std::stoi(limit);
+        }
+        if (!afterId.empty()) {
+            query.afterId = std::stoi(afterId);
+        }
+        if (!difficulty.empty()) {
+            query.difficulty = std::stoi(difficulty);
+        }
+    } catch (const std::exception &) {
+        return "limit, after_id and difficulty must be integers";
+    }
+    if ((!query.dueFrom.empty() && !isDateParam(query.dueFrom)) || (!query.dueTo.empty() && !isDateParam(query.dueTo))) {
+        return "due_from and due_to must be in YYYY-MM-DD format";
+    }
+    return "";
+}
+
+// {"tasks": [...], "nextCursor": <id or null>}
+Json::Value pageToJson(const TaskPage &page) {
+    Json::Value result;
+    Json::Value taskList(Json::arrayValue);
+    for (const auto &task : page.tasks) {
+        taskList.append(taskToJson(task));
+    }
+    result["tasks"] = taskList;
+    result["nextCursor"] = page.nextCursor ? Json::Value(*page.nextCursor) : Json::Value(Json::nullValue);
+    return result;
+}
+
+// Validates one task object from a request body and fills in `task`.
+// Returns an error message, or an empty string when the object is valid.
+std::string taskFromJson(const Json::Value &json, Task &task) {
+    if (!json.isObject() || !json.isMember("header") || !json.isMember("difficulty")) {
+        return "Missing required fields";
+    }
+
+    task.difficulty = json["difficulty"].asInt();
+    if (task.difficulty < 1 || task.difficulty > 5) {
+        return "Difficulty must be between 1 and 5";
+    }
+
+    task.header = json["header"].asString();
+    task.description = json.isMember("description") ? json["description"].asString() : "";
+    task.dueDate = json.isMember("dueDate") ? json["dueDate"].asString() : "";
+
+    if (!task.dueDate.empty() && !isDateParam(task.dueDate)) {
+        return "Due date must be in YYYY-MM-DD format";
+    }
+    return "";
+}
+
+// Fills `prioritizer` from ?strategy=, ?dueWeight= and ?difficultyWeight= (see
+// TaskPrioritizer::fromParameters). Returns an error message, or an empty string.
+std::string prioritizerFromRequest(const HttpRequestPtr &req, TaskPrioritizer &prioritizer) {
+    try {
+        prioritizer = TaskPrioritizer::fromParameters(req->getParameter("strategy"), req->getParameter("dueWeight"),
+                                                      req->getParameter("difficultyWeight"));
+    } catch (const std::invalid_argument &e) {
+        return e.what();
+    }
+    return "";
+}
+
+// {"strategies": [{"id", "key", "name", "description"[, "weights"]}, ...], "default": "balanced"}.
+// "key" is the value accepted by ?strategy= on /api/tasks/prioritized.
+Json::Value strategiesToJson() {
+    Json::Value result;
+    Json::Value strategies(Json::arrayValue);
+    for (auto strategy : TaskPrioritizer::allStrategies()) {
+        Json::Value entry;
+        entry["id"] = static_cast<int>(strategy);
+        entry["key"] = TaskPrioritizer::strategyName(strategy);
+        entry["name"] = TaskPrioritizer::strategyTitle(strategy);
+        entry["description"] = TaskPrioritizer::strategyDescription(strategy);
+        if (strategy == TaskPrioritizer::Strategy::WEIGHTED) {
+            TaskPrioritizer::Weights defaults;
+            entry["weights"]["dueWeight"] = defaults.dueDate;
+            entry["weights"]["difficultyWeight"] = defaults.difficulty;
+        }
+        strategies.append(entry);
+    }
+    result["strategies"] = strategies;
+    result["default"] = TaskPrioritizer::strategyName(TaskPrioritizer::Strategy::BALANCED);
+    return result;
+}
+
+// Runs `job` (which answers through the callback it is given) on the database
+// executor instead of the calling IO thread. When the lane's queue is full the
+// request is answered with 503 right away rather than queueing without bound.
+template <typename Job>
+void runOnDb(DbExecutor &executor, DbExecutor::Lane lane, ResponseCallback &&callback, Job job) {
+    auto shared = std::make_shared<ResponseCallback>(std::move(callback));
+    bool queued = executor.submit(lane, [shared, job = std::move(job)]() mutable {
+        job(*shared);
+    });
+    if (!queued) {
+        auto resp = HttpResponse::newHttpResponse();
+        resp->setStatusCode(k503ServiceUnavailable);
+        resp->setBody("Server busy, retry later");
+        (*shared)(resp);
+    }
+}
+
+// Answers 304 on the IO thread, without queueing a database job, when the client
+// already has the current representation
+bool answerNotModified(const HttpRequestPtr &req, const std::string &etag, const ResponseCallback &callback) {
+    if (!etagMatches(req->getHeader("If-None-Match"), etag)) {
+        return false;
+    }
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setStatusCode(k304NotModified);
+    resp->addHeader("ETag", etag);
+    callback(resp);
+    return true;
+}
+
+// Tags the 200 responses passed to `callback` with `etag`
+ResponseCallback withETag(ResponseCallback &&callback, std::string etag) {
+    return [callback = std::move(callback), etag = std::move(etag)](const HttpResponsePtr &resp) {
+        if (resp->statusCode() == k200OK) {
+            resp->addHeader("ETag", etag);
+        }
+        callback(resp);
+    };
+}
+
+// ResponseCache slots; PRIORITIZED_VIEW + strategy for each prioritization strategy
+enum : std::size_t { OPEN_VIEW, COMPLETED_VIEW, PRIORITIZED_VIEW };
+
+// 200 JSON response carrying already serialized bytes
+HttpResponsePtr jsonBytesResponse(const std::string &bytes) {
+    auto resp = HttpResponse::newHttpResponse();
+    resp->setContentTypeCode(CT_APPLICATION_JSON);
+    resp->setBody(bytes);
+    return resp;
+}
+
+// {"tasks":[...]} for all open or completed tasks, written straight from the result rows
+std::string listBody(const ToDoList &todoList, bool completed) {
+    std::string body;
+    JsonWriter json(body);
+    json.beginObject().key("tasks").beginArray();
+    auto append = [&json](const TaskView &task) { json.task(task); };
+    if (completed) {
+        todoList.forEachCompletedTask(append);
+    } else {
+        todoList.forEachTask(append);
+    }
+    json.endArray().endObject();
+    return body;
+}
+
+// {"tasks":[...]}
+std::string tasksBody(const std::vector<Task> &tasks) {
+    std::string body;
+    std::size_t reserve = 32;
+    for (const auto &task : tasks) {
+        reserve += JsonWriter::estimateTaskSize(task);
+    }
+    body.reserve(reserve);
+    JsonWriter json(body);
+    json.beginObject().key("tasks").beginArray();
+    for (const auto &task : tasks) {
+        json.task(task);
+    }
+    json.endArray().endObject();
+    return body;
+}
+
+// Number of Drogon IO threads, from TODO_API_THREADS (defaults to one per core).
+// ToDoList hands each concurrently reading thread its own SQLite connection.
+size_t configuredThreadCount() {
+    size_t threads = std::thread::hardware_concurrency();
+    if (const char* env = std::getenv("TODO_API_THREADS")) {
+        try {
+            threads = std::stoul(env);
+        } catch (const std::exception &) {
+            std::cerr << "Ignoring invalid TODO_API_THREADS value: " << env << std::endl;
+        }
+    }
+    return threads > 0 ? threads : 1;
+}
+
+// Number of database read threads, from TODO_DB_THREADS (defaults to one per core)
+unsigned configuredDbThreadCount() {
+    if (const char* env = std::getenv("TODO_DB_THREADS")) {
+        try {
+            return static_cast<unsigned>(std::stoul(env));
+        } catch (const std::exception &) {
+            std::cerr << "Ignoring invalid TODO_DB_THREADS value: " << env << std::endl;
+        }
+    }
+    return 0;
+}
+
 int main() {
     // Ensure data directory exists
     std::filesystem::create_directories("data");
@@ -45,11 +272,34 @@ int main() {
     try {
         todoList.connect("data/tasks.db");
         std::cout << "Connected to database successfully.\n";
+
+        // TODO_PRIORITY_ENGINE=sql orders prioritized tasks in SQLite instead of in memory
+        const char* engine = std::getenv("TODO_PRIORITY_ENGINE");
+        if (engine && std::string(engine) == "sql") {
+            todoList.setPriorityEngine(ToDoList::PriorityEngine::SQL);
+        }
     } catch (const std::exception &e) {
         std::cerr << "Database error: " << e.what() << std::endl;
         return 1;
     }
 
+    // With group commit, several write threads are needed for batches to form: each one
+    // blocks until the batch holding its write commits
+    GroupCommitOptions groupCommit = GroupCommitOptions::fromEnvironment();
+    unsigned writeThreads = 1;
+    if (groupCommit.enabled) {
+        todoList.setGroupCommit(groupCommit);
+        writeThreads = 16;
+    }
+
+    // SQLite calls block, so handlers hand them to these threads and answer from
+    // there; reads and writes have separate queues (see DbExecutor)
+    DbExecutor dbExecutor(configuredDbThreadCount(), writeThreads);
+
+    // Serialized bodies of the unfiltered open/completed lists and each strategy's full
+    // prioritized order, shared by all threads and rebuilt after the data version changes
+    ResponseCache responseCache(PRIORITIZED_VIEW + TaskPrioritizer::allStrategies().size());
+
     // Health check endpoint for monitoring
     app().registerHandler("/health", 
         [](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
@@ -61,311 +311,488 @@ int main() {
         },
         {Get});
 
-    // GET all tasks
+    // GET all tasks (or one page of them when limit/after_id/filters are given)
     app().registerHandler("/api/tasks", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
-            try {
-                auto tasks = todoList.getTasks();
-                Json::Value result;
-                Json::Value taskList(Json::arrayValue);
-
-                for (const auto &task : tasks) {
-                    taskList.append(taskToJson(task));
+        [&todoList, &dbExecutor, &responseCache](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            std::uint64_t version = todoList.getDataVersion();  // Before the ETag, see dataETag
+            std::string etag = dataETag(todoList);
+            if (answerNotModified(req, etag, callback)) {
+                return;
+            }
+            // The unfiltered list is served from the cache right here when it is current
+            bool unfiltered = req->getParameters().empty();
+            if (unfiltered) {
+                if (auto bytes = responseCache.get(OPEN_VIEW, version, etag)) {
+                    withETag(std::move(callback), etag)(jsonBytesResponse(*bytes));
+                    return;
                 }
-                result["tasks"] = taskList;
-
-                auto resp = HttpResponse::newHttpJsonResponse(result);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
             }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, &responseCache, req, version, etag, unfiltered](const ResponseCallback &callback) {
+                try {
+                    TaskQuery query;
+                    query.completed = false;
+                    bool paged = false;
+                    std::string error = taskQueryFromRequest(req, query, paged);
+                    if (!error.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody(error);
+                        callback(resp);
+                        return;
+                    }
+                    if (paged) {
+                        auto resp = HttpResponse::newHttpJsonResponse(pageToJson(todoList.getTasksPage(query)));
+                        callback(resp);
+                        return;
+                    }
+
+                    std::string body = listBody(todoList, false);
+                    if (unfiltered) {
+                        callback(jsonBytesResponse(*responseCache.put(OPEN_VIEW, version, etag, std::move(body))));
+                    } else {
+                        callback(jsonBytesResponse(body));
+                    }
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Get});
 
     // GET a single task by ID
     app().registerHandler("/api/tasks/{id}", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
-            try {
-                std::cout << "Received request for task ID: " << id << std::endl;
-                
-                int taskId = std::stoi(id);
-                std::cout << "Converted to int: " << taskId << std::endl;
-                
-                auto tasks = todoList.getTasks();
-                std::cout << "Found " << tasks.size() << " total tasks" << std::endl;
-                
-                for (const auto &task : tasks) {
-                    if (task.id == taskId) {
-                        std::cout << "Found matching task with ID " << taskId << std::endl;
-                        auto resp = HttpResponse::newHttpJsonResponse(taskToJson(task));
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
+            std::string etag = dataETag(todoList);
+            if (answerNotModified(req, etag, callback)) {
+                return;
+            }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, req, id](const ResponseCallback &callback) {
+                try {
+                    int taskId = std::stoi(id);
+                    auto task = todoList.getTaskById(taskId);
+                    if (task) {
+                        auto resp = HttpResponse::newHttpJsonResponse(taskToJson(*task));
                         callback(resp);
                         return;
                     }
-                }
                 
-                std::cout << "No task found with ID " << taskId << std::endl;
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k404NotFound);
-                resp->setBody("Task not found");
-                callback(resp);
-            } catch (const std::exception &e) {
-                std::cerr << "Error processing request: " << e.what() << std::endl;
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k404NotFound);
+                    resp->setBody("Task not found");
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    std::cerr << "Error processing request: " << e.what() << std::endl;
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Get});
 
-    // GET all completed tasks
+    // GET all completed tasks (pageable like /api/tasks)
     app().registerHandler("/api/tasks/completed", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
-            try {
-                auto tasks = todoList.getCompletedTasks();
-                Json::Value result;
-                Json::Value taskList(Json::arrayValue);
-
-                for (const auto &task : tasks) {
-                    taskList.append(taskToJson(task));
+        [&todoList, &dbExecutor, &responseCache](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            std::uint64_t version = todoList.getDataVersion();  // Before the ETag, see dataETag
+            std::string etag = dataETag(todoList);
+            if (answerNotModified(req, etag, callback)) {
+                return;
+            }
+            // The unfiltered list is served from the cache right here when it is current
+            bool unfiltered = req->getParameters().empty();
+            if (unfiltered) {
+                if (auto bytes = responseCache.get(COMPLETED_VIEW, version, etag)) {
+                    withETag(std::move(callback), etag)(jsonBytesResponse(*bytes));
+                    return;
                 }
-                result["tasks"] = taskList;
-
-                auto resp = HttpResponse::newHttpJsonResponse(result);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
             }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, &responseCache, req, version, etag, unfiltered](const ResponseCallback &callback) {
+                try {
+                    TaskQuery query;
+                    query.completed = true;
+                    bool paged = false;
+                    std::string error = taskQueryFromRequest(req, query, paged);
+                    if (!error.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody(error);
+                        callback(resp);
+                        return;
+                    }
+                    if (paged) {
+                        auto resp = HttpResponse::newHttpJsonResponse(pageToJson(todoList.getTasksPage(query)));
+                        callback(resp);
+                        return;
+                    }
+
+                    std::string body = listBody(todoList, true);
+                    if (unfiltered) {
+                        callback(jsonBytesResponse(*responseCache.put(COMPLETED_VIEW, version, etag, std::move(body))));
+                    } else {
+                        callback(jsonBytesResponse(body));
+                    }
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
+        },
+        {Get});
+
+    // GET full-text search results (?q=words, optional ?limit=N up to 100, default 20)
+    app().registerHandler("/api/tasks/search", 
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            std::string etag = dataETag(todoList);
+            if (answerNotModified(req, etag, callback)) {
+                return;
+            }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, req](const ResponseCallback &callback) {
+                try {
+                    const std::string &text = req->getParameter("q");
+                    const std::string &limitParam = req->getParameter("limit");
+                    int limit = 20;
+                    if (!limitParam.empty()) {
+                        try {
+                            limit = std::stoi(limitParam);
+                        } catch (const std::exception &) {
+                            limit = 0;
+                        }
+                    }
+                    if (text.empty() || limit < 1 || limit > 100) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody(text.empty() ? "q is required" : "limit must be between 1 and 100");
+                        callback(resp);
+                        return;
+                    }
+
+                    Json::Value result;
+                    Json::Value taskList(Json::arrayValue);
+                    for (const auto &task : todoList.searchTasks(text, static_cast<std::size_t>(limit))) {
+                        taskList.append(taskToJson(task));
+                    }
+                    result["tasks"] = taskList;
+
+                    auto resp = HttpResponse::newHttpJsonResponse(result);
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
+        },
+        {Get});
+
+    // GET header suggestions for type-ahead (?prefix=text, optional ?limit=N up to 50, default 10)
+    app().registerHandler("/api/tasks/suggest", 
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            std::string etag = dataETag(todoList);
+            if (answerNotModified(req, etag, callback)) {
+                return;
+            }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, req](const ResponseCallback &callback) {
+                try {
+                    const std::string &limitParam = req->getParameter("limit");
+                    int limit = 10;
+                    if (!limitParam.empty()) {
+                        try {
+                            limit = std::stoi(limitParam);
+                        } catch (const std::exception &) {
+                            limit = 0;
+                        }
+                    }
+                    if (limit < 1 || limit > 50) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody("limit must be between 1 and 50");
+                        callback(resp);
+                        return;
+                    }
+
+                    Json::Value result;
+                    Json::Value suggestions(Json::arrayValue);
+                    for (const auto &suggestion : todoList.suggestHeaders(req->getParameter("prefix"), static_cast<std::size_t>(limit))) {
+                        Json::Value entry;
+                        entry["header"] = suggestion.header;
+                        entry["count"] = suggestion.count;
+                        suggestions.append(entry);
+                    }
+                    result["suggestions"] = suggestions;
+
+                    auto resp = HttpResponse::newHttpJsonResponse(result);
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Get});
 
     // GET prioritized tasks
     app().registerHandler("/api/tasks/prioritized", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
-            try {
-                auto tasks = todoList.getPrioritizedTasks();
-                Json::Value result;
-                Json::Value taskList(Json::arrayValue);
-
-                for (const auto &task : tasks) {
-                    taskList.append(taskToJson(task));
-                }
-                result["tasks"] = taskList;
-
-                auto resp = HttpResponse::newHttpJsonResponse(result);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
+        [&todoList, &dbExecutor, &responseCache](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            std::uint64_t version = todoList.getDataVersion();  // Before the ETag, see dataETag
+            std::string etag = dataETag(todoList, std::to_string(currentEpochDay()));
+            if (answerNotModified(req, etag, callback)) {
+                return;
             }
+            runOnDb(dbExecutor, DbExecutor::Lane::READ, withETag(std::move(callback), etag), [&todoList, &responseCache, req, version, etag](const ResponseCallback &callback) {
+                try {
+                    // Optional ?limit=N returns only the N most urgent tasks
+                    std::size_t limit = 0;
+                    const std::string &limitParam = req->getParameter("limit");
+                    if (!limitParam.empty()) {
+                        int parsed = -1;
+                        try {
+                            parsed = std::stoi(limitParam);
+                        } catch (const std::exception &) {
+                        }
+                        if (parsed < 1) {
+                            auto resp = HttpResponse::newHttpResponse();
+                            resp->setStatusCode(k400BadRequest);
+                            resp->setBody("limit must be a positive integer");
+                            callback(resp);
+                            return;
+                        }
+                        limit = static_cast<std::size_t>(parsed);
+                    }
+
+                    // Optional ?strategy=<name> (see /api/prioritization/strategies)
+                    TaskPrioritizer prioritizer;
+                    std::string error = prioritizerFromRequest(req, prioritizer);
+                    if (!error.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody(error);
+                        callback(resp);
+                        return;
+                    }
+
+                    // The full order for a strategy's default weights is a shared view
+                    bool defaultView = limit == 0 && req->getParameter("dueWeight").empty() &&
+                                       req->getParameter("difficultyWeight").empty();
+                    auto build = [&] { return tasksBody(todoList.getPrioritizedTasks(prioritizer, limit)); };
+                    if (defaultView) {
+                        std::size_t slot = PRIORITIZED_VIEW + static_cast<std::size_t>(prioritizer.getStrategy());
+                        callback(jsonBytesResponse(*responseCache.getOrBuild(slot, version, etag, build)));
+                    } else {
+                        callback(jsonBytesResponse(build()));
+                    }
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Get});
 
     // POST new task
     app().registerHandler("/api/tasks", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
-            try {
-                auto json = req->getJsonObject();
-                if (!json || !json->isMember("header") || !json->isMember("difficulty")) {
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req](const ResponseCallback &callback) {
+                try {
+                    auto json = req->getJsonObject();
+                    Task task;
+                    std::string error = json ? taskFromJson(*json, task) : "Missing required fields";
+                    if (!error.empty()) {
+                        auto resp = HttpResponse::newHttpResponse();
+                        resp->setStatusCode(k400BadRequest);
+                        resp->setBody(error);
+                        callback(resp);
+                        return;
+                    }
+
+                    todoList.addTask(task.header, task.description, task.difficulty, task.dueDate);
                     auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k400BadRequest);
-                    resp->setBody("Missing required fields");
+                    resp->setStatusCode(k201Created);
                     callback(resp);
-                    return;
-                }
-
-                int difficulty = (*json)["difficulty"].asInt();
-                if (difficulty < 1 || difficulty > 5) {
+                } catch (const std::exception &e) {
                     auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k400BadRequest);
-                    resp->setBody("Difficulty must be between 1 and 5");
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
                     callback(resp);
-                    return;
                 }
+            });
+        },
+        {Post});
 
-                std::string header = (*json)["header"].asString();
-                std::string description = json->isMember("description") ? (*json)["description"].asString() : "";
-                std::string dueDate = json->isMember("dueDate") ? (*json)["dueDate"].asString() : "";
-
-                if (!dueDate.empty()) {
-                    if (dueDate.length() != 10 || dueDate[4] != '-' || dueDate[7] != '-') {
+    // POST several tasks at once: {"tasks": [{...}, ...]} -> {"ids": [...]}
+    // All tasks are validated first and inserted in a single transaction.
+    app().registerHandler("/api/tasks/batch", 
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req](const ResponseCallback &callback) {
+                try {
+                    auto json = req->getJsonObject();
+                    if (!json || !json->isMember("tasks") || !(*json)["tasks"].isArray()) {
                         auto resp = HttpResponse::newHttpResponse();
                         resp->setStatusCode(k400BadRequest);
-                        resp->setBody("Due date must be in YYYY-MM-DD format");
+                        resp->setBody("Body must contain a \"tasks\" array");
                         callback(resp);
                         return;
                     }
-                }
 
-                todoList.addTask(header, description, difficulty, dueDate);
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k201Created);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
+                    const Json::Value &items = (*json)["tasks"];
+                    std::vector<Task> tasks(items.size());
+                    for (Json::ArrayIndex i = 0; i < items.size(); ++i) {
+                        std::string error = taskFromJson(items[i], tasks[i]);
+                        if (!error.empty()) {
+                            auto resp = HttpResponse::newHttpResponse();
+                            resp->setStatusCode(k400BadRequest);
+                            resp->setBody("Task " + std::to_string(i) + ": " + error);
+                            callback(resp);
+                            return;
+                        }
+                    }
+
+                    auto ids = todoList.addTasks(tasks);
+                    Json::Value result;
+                    Json::Value idList(Json::arrayValue);
+                    for (int id : ids) {
+                        idList.append(id);
+                    }
+                    result["ids"] = idList;
+
+                    auto resp = HttpResponse::newHttpJsonResponse(result);
+                    resp->setStatusCode(k201Created);
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Post});
 
     // DELETE task
     app().registerHandler("/api/tasks/{id}", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
-            try {
-                int taskId = std::stoi(id);
-                todoList.deleteTask(taskId);
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k204NoContent);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
-        },
-        {Delete});
-
-    // PUT update task
-    app().registerHandler("/api/tasks/{id}", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
-            try {
-                int taskId = std::stoi(id);
-                auto json = req->getJsonObject();
-                if (!json || !json->isMember("header") || !json->isMember("difficulty")) {
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req, id](const ResponseCallback &callback) {
+                try {
+                    int taskId = std::stoi(id);
+                    todoList.deleteTask(taskId);
                     auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k400BadRequest);
-                    resp->setBody("Missing required fields");
+                    resp->setStatusCode(k204NoContent);
                     callback(resp);
-                    return;
-                }
-
-                int difficulty = (*json)["difficulty"].asInt();
-                if (difficulty < 1 || difficulty > 5) {
+                } catch (const std::exception &e) {
                     auto resp = HttpResponse::newHttpResponse();
-                    resp->setStatusCode(k400BadRequest);
-                    resp->setBody("Difficulty must be between 1 and 5");
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
                     callback(resp);
-                    return;
                 }
+            });
+        },
+        {Delete});
 
-                std::string header = (*json)["header"].asString();
-                std::string description = json->isMember("description") ? (*json)["description"].asString() : "";
-                std::string dueDate = json->isMember("dueDate") ? (*json)["dueDate"].asString() : "";
-
-                if (!dueDate.empty()) {
-                    if (dueDate.length() != 10 || dueDate[4] != '-' || dueDate[7] != '-') {
+    // PUT update task
+    app().registerHandler("/api/tasks/{id}", 
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req, id](const ResponseCallback &callback) {
+                try {
+                    int taskId = std::stoi(id);
+                    auto json = req->getJsonObject();
+                    Task task;
+                    std::string error = json ? taskFromJson(*json, task) : "Missing required fields";
+                    if (!error.empty()) {
                         auto resp = HttpResponse::newHttpResponse();
                         resp->setStatusCode(k400BadRequest);
-                        resp->setBody("Due date must be in YYYY-MM-DD format");
+                        resp->setBody(error);
                         callback(resp);
                         return;
                     }
-                }
 
-                todoList.editTask(taskId, header, description, difficulty, dueDate);
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k200OK);
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
+                    todoList.editTask(taskId, task.header, task.description, task.difficulty, task.dueDate);
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k200OK);
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
+                }
+            });
         },
         {Put});
 
     // POST mark task as completed
     app().registerHandler("/api/tasks/{id}/complete", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
-            try {
-                int taskId = std::stoi(id);
-                bool marked = todoList.markTaskAsCompleted(taskId);
-                auto resp = HttpResponse::newHttpResponse();
-                if (marked) {
-                    resp->setStatusCode(k200OK);
-                } else {
-                    resp->setStatusCode(k404NotFound);
-                    resp->setBody("Task not found");
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req, id](const ResponseCallback &callback) {
+                try {
+                    int taskId = std::stoi(id);
+                    bool marked = todoList.markTaskAsCompleted(taskId);
+                    auto resp = HttpResponse::newHttpResponse();
+                    if (marked) {
+                        resp->setStatusCode(k200OK);
+                    } else {
+                        resp->setStatusCode(k404NotFound);
+                        resp->setBody("Task not found");
+                    }
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
                 }
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
+            });
         },
         {Post});
 
     // POST unmark task as completed
     app().registerHandler("/api/tasks/{id}/uncomplete", 
-        [&todoList](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
-            try {
-                int taskId = std::stoi(id);
-                bool unmarked = todoList.unmarkTaskAsCompleted(taskId);
-                auto resp = HttpResponse::newHttpResponse();
-                if (unmarked) {
-                    resp->setStatusCode(k200OK);
-                } else {
-                    resp->setStatusCode(k404NotFound);
-                    resp->setBody("Task not found");
+        [&todoList, &dbExecutor](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback, const std::string &id) {
+            runOnDb(dbExecutor, DbExecutor::Lane::WRITE, std::move(callback), [&todoList, req, id](const ResponseCallback &callback) {
+                try {
+                    int taskId = std::stoi(id);
+                    bool unmarked = todoList.unmarkTaskAsCompleted(taskId);
+                    auto resp = HttpResponse::newHttpResponse();
+                    if (unmarked) {
+                        resp->setStatusCode(k200OK);
+                    } else {
+                        resp->setStatusCode(k404NotFound);
+                        resp->setBody("Task not found");
+                    }
+                    callback(resp);
+                } catch (const std::exception &e) {
+                    auto resp = HttpResponse::newHttpResponse();
+                    resp->setStatusCode(k500InternalServerError);
+                    resp->setBody(std::string("Error: ") + e.what());
+                    callback(resp);
                 }
-                callback(resp);
-            } catch (const std::exception &e) {
-                auto resp = HttpResponse::newHttpResponse();
-                resp->setStatusCode(k500InternalServerError);
-                resp->setBody(std::string("Error: ") + e.what());
-                callback(resp);
-            }
+            });
         },
         {Post});
 
     // GET prioritization strategies
     app().registerHandler("/api/prioritization/strategies", 
         [](const HttpRequestPtr &req, std::function<void(const HttpResponsePtr &)> &&callback) {
-            Json::Value result;
-            Json::Value strategies(Json::arrayValue);
-
-            Json::Value dueDateFirst;
-            dueDateFirst["id"] = static_cast<int>(TaskPrioritizer::Strategy::DUE_DATE_FIRST);
-            dueDateFirst["name"] = "Due Date First";
-            dueDateFirst["description"] = "Prioritize tasks by due date, then by difficulty";
-
-            Json::Value difficultyFirst;
-            difficultyFirst["id"] = static_cast<int>(TaskPrioritizer::Strategy::DIFFICULTY_FIRST);
-            difficultyFirst["name"] = "Difficulty First";
-            difficultyFirst["description"] = "Prioritize easier tasks first, then by due date";
-
-            Json::Value balanced;
-            balanced["id"] = static_cast<int>(TaskPrioritizer::Strategy::BALANCED);
-            balanced["name"] = "Balanced";
-            balanced["description"] = "Use a weighted algorithm considering both due date and difficulty";
-
-            strategies.append(dueDateFirst);
-            strategies.append(difficultyFirst);
-            strategies.append(balanced);
-
-            result["strategies"] = strategies;
-            auto resp = HttpResponse::newHttpJsonResponse(result);
+            auto resp = HttpResponse::newHttpJsonResponse(strategiesToJson());
             callback(resp);
         },
         {Get});
 
     // Start the server
-    std::cout << "Starting API server on http://localhost:8080\n";
+    size_t threadCount = configuredThreadCount();
+    std::cout << "Starting API server on http://localhost:8080 with " << threadCount << " threads\n";
     app().setLogLevel(trantor::Logger::kWarn);
+    app().setThreadNum(threadCount);
+    app().setClientMaxBodySize(32 * 1024 * 1024);  // Room for /api/tasks/batch imports
     app().addListener("0.0.0.0", 8080);
     // Add CORS headers
     app().registerHandler("/.*", [](const HttpRequestPtr& req, 
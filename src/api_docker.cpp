@@ -1,147 +1,365 @@
 #include "Task.h"
 #include "TaskPrioritizer.h"
 #include "ToDoList.h"
+#include "DueDate.h"
+#include "ETag.h"
+#include "JsonWriter.h"
+#include "JsonReader.h"
+#include "ResponseCache.h"
+#include "HttpRequestParser.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <filesystem>
 #include <ctime>
-#include <sstream>
 #include <cstring>
+#include <cctype>
+#include <cstdlib>
+#include <charconv>
+#include <optional>
 #include <unistd.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <signal.h>
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <chrono>
+#include <atomic>
+#include <csignal>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <deque>
+#include <unordered_map>
 
-// Simple JSON helper functions
-std::string escapeJsonString(const std::string& s) {
-    std::ostringstream o;
-    for (auto c = s.cbegin(); c != s.cend(); c++) {
-        if (*c == '"' || *c == '\\' || ('\x00' <= *c && *c <= '\x1f')) {
-            o << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(*c);
-        } else {
-            o << *c;
+// HTTP responses are built in a single buffer: the head is written first with the
+// Content-Length value left blank (spaces, which HTTP allows before a field value),
+// the body is streamed in after it with JsonWriter, and the length is patched in at
+// the end. With a good reserve hint that is one allocation per response.
+constexpr std::size_t CONTENT_LENGTH_WIDTH = 20;
+
+std::string_view statusText(int statusCode) {
+    switch (statusCode) {
+    case 200: return "OK";
+    case 201: return "Created";
+    case 204: return "No Content";
+    case 400: return "Bad Request";
+    case 404: return "Not Found";
+    case 413: return "Payload Too Large";
+    case 431: return "Request Header Fields Too Large";
+    case 501: return "Not Implemented";
+    case 505: return "HTTP Version Not Supported";
+    default: throw std::runtime_error("No status text for " + std::to_string(statusCode));
+    }
+}
+
+// The status line, Content-Type and CORS headers of a response, built once per
+// status and content type rather than piece by piece for every response
+const std::string& headerBlock(int statusCode, std::string_view contentType) {
+    struct Block {
+        int statusCode;
+        std::string_view contentType;
+        std::string text;
+    };
+    static const std::vector<Block> blocks = [] {
+        std::vector<Block> built;
+        for (int code : {200, 201, 204, 400, 404, 413, 431, 501, 505}) {
+            for (std::string_view type : {"application/json", "text/plain"}) {
+                std::string text = "HTTP/1.1 " + std::to_string(code) + " " + std::string(statusText(code)) +
+                                   "\r\nContent-Type: " + std::string(type) +
+                                   "\r\nAccess-Control-Allow-Origin: *\r\n"
+                                   "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+                                   "Access-Control-Allow-Headers: Content-Type\r\n";
+                built.push_back({code, type, std::move(text)});
+            }
+        }
+        return built;
+    }();
+    for (const auto& block : blocks) {
+        if (block.statusCode == statusCode && block.contentType == contentType) {
+            return block.text;
         }
     }
-    return o.str();
+    throw std::runtime_error("No header block for " + std::to_string(statusCode) + " " + std::string(contentType));
 }
 
-std::string taskToJson(const Task& task) {
-    std::ostringstream ss;
-    ss << "{";
-    ss << "\"id\":" << task.id << ",";
-    ss << "\"header\":\"" << escapeJsonString(task.header) << "\",";
-    ss << "\"description\":\"" << escapeJsonString(task.description) << "\",";
-    ss << "\"completed\":" << (task.completed ? "true" : "false") << ",";
-    ss << "\"difficulty\":" << task.difficulty << ",";
-    ss << "\"dueDate\":\"" << escapeJsonString(task.dueDate) << "\"";
-    ss << "}";
-    return ss.str();
+// Writes the status line and headers; returns where the body starts
+std::size_t beginHttpResponse(std::string& out, int statusCode, std::string_view contentType,
+                              std::size_t bodyReserve, std::string_view etag = {}) {
+    const std::string& block = headerBlock(statusCode, contentType);
+    out.reserve(out.size() + block.size() + 64 + etag.size() + bodyReserve);
+    out += block;
+    if (!etag.empty()) {
+        out += "ETag: ";
+        out += etag;
+        out += "\r\n";
+    }
+    out += "Content-Length:";
+    out.append(CONTENT_LENGTH_WIDTH, ' ');
+    out += "\r\n\r\n";
+    return out.size();
 }
 
-std::string tasksToJson(const std::vector<Task>& tasks) {
-    std::ostringstream ss;
-    ss << "{\"tasks\":[";
-    
-    for (size_t i = 0; i < tasks.size(); ++i) {
-        if (i > 0) {
-            ss << ",";
-        }
-        ss << taskToJson(tasks[i]);
+// Fills in the Content-Length left blank by beginHttpResponse, right-aligned
+void finishHttpResponse(std::string& out, std::size_t bodyStart) {
+    char digits[CONTENT_LENGTH_WIDTH];
+    char* end = std::to_chars(digits, digits + sizeof(digits), out.size() - bodyStart).ptr;
+    std::size_t length = static_cast<std::size_t>(end - digits);
+    std::memcpy(&out[bodyStart - 4 - length], digits, length);
+}
+
+std::string makeHttpResponse(int statusCode, std::string_view contentType, std::string_view body) {
+    std::string response;
+    std::size_t bodyStart = beginHttpResponse(response, statusCode, contentType, body.size());
+    response += body;
+    finishHttpResponse(response, bodyStart);
+    return response;
+}
+
+// A response that never changes, built once and then shared by every reply like
+// the ResponseCache entries
+ResponseCache::Bytes fixedResponse(int statusCode, std::string_view contentType, std::string_view body) {
+    return std::make_shared<const std::string>(makeHttpResponse(statusCode, contentType, body));
+}
+
+// application/json response whose body `write` streams into the response buffer.
+// `etag` (optional) tags responses built from task data, see dataETag.
+template <typename Write>
+std::string jsonResponse(int statusCode, std::size_t bodyReserve, const std::string& etag, Write&& write) {
+    std::string response;
+    std::size_t bodyStart = beginHttpResponse(response, statusCode, "application/json", bodyReserve, etag);
+    JsonWriter json(response);
+    write(json);
+    finishHttpResponse(response, bodyStart);
+    return response;
+}
+
+template <typename Write>
+std::string okJsonResponse(std::size_t bodyReserve, const std::string& etag, Write&& write) {
+    return jsonResponse(200, bodyReserve, etag, std::forward<Write>(write));
+}
+
+std::size_t tasksReserve(const std::vector<Task>& tasks) {
+    std::size_t reserve = 48;
+    for (const auto& task : tasks) {
+        reserve += JsonWriter::estimateTaskSize(task);
     }
-    
-    ss << "]}";
-    return ss.str();
+    return reserve;
 }
 
-// HTTP Response helpers
-std::string makeHttpResponse(int statusCode, const std::string& statusText, const std::string& contentType, const std::string& body) {
-    std::ostringstream response;
-    response << "HTTP/1.1 " << statusCode << " " << statusText << "\r\n";
-    response << "Content-Type: " << contentType << "\r\n";
-    response << "Content-Length: " << body.length() << "\r\n";
-    response << "Access-Control-Allow-Origin: *\r\n";
-    response << "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n";
-    response << "Access-Control-Allow-Headers: Content-Type\r\n";
-    response << "\r\n";
-    response << body;
-    return response.str();
+// {"tasks":[...]}
+std::string tasksResponse(const std::vector<Task>& tasks, const std::string& etag) {
+    return okJsonResponse(tasksReserve(tasks), etag, [&tasks](JsonWriter& json) {
+        json.beginObject().key("tasks").beginArray();
+        for (const auto& task : tasks) {
+            json.task(task);
+        }
+        json.endArray().endObject();
+    });
 }
 
-std::string okJson(const std::string& json) {
-    return makeHttpResponse(200, "OK", "application/json", json);
+// {"tasks":[...],"nextCursor":id or null}
+std::string pageResponse(const TaskPage& page, const std::string& etag) {
+    return okJsonResponse(tasksReserve(page.tasks), etag, [&page](JsonWriter& json) {
+        json.beginObject().key("tasks").beginArray();
+        for (const auto& task : page.tasks) {
+            json.task(task);
+        }
+        json.endArray().key("nextCursor");
+        if (page.nextCursor) {
+            json.value(*page.nextCursor);
+        } else {
+            json.null();
+        }
+        json.endObject();
+    });
 }
 
-std::string created() {
-    return makeHttpResponse(201, "Created", "text/plain", "");
+// {"tasks":[...]} for all open or completed tasks, streamed from the database cursor.
+// The row count is unknown up front, so reserve what the previous listing needed.
+std::string listResponse(const ToDoList& todoList, bool completed, const std::string& etag) {
+    thread_local std::size_t lastSize[2] = {4096, 4096};
+    std::string response = okJsonResponse(lastSize[completed] + lastSize[completed] / 8, etag, [&](JsonWriter& json) {
+        json.beginObject().key("tasks").beginArray();
+        auto append = [&json](const TaskView& task) { json.task(task); };
+        if (completed) {
+            todoList.forEachCompletedTask(append);
+        } else {
+            todoList.forEachTask(append);
+        }
+        json.endArray().endObject();
+    });
+    lastSize[completed] = response.size();
+    return response;
 }
 
-std::string noContent() {
-    return makeHttpResponse(204, "No Content", "text/plain", "");
+// 200 with an empty JSON object, the answer to a successful update
+const ResponseCache::Bytes& okEmptyJson() {
+    static const ResponseCache::Bytes response = fixedResponse(200, "application/json", "{}");
+    return response;
+}
+
+const ResponseCache::Bytes& created() {
+    static const ResponseCache::Bytes response = fixedResponse(201, "text/plain", "");
+    return response;
+}
+
+const ResponseCache::Bytes& noContent() {
+    static const ResponseCache::Bytes response = fixedResponse(204, "text/plain", "");
+    return response;
 }
 
 std::string badRequest(const std::string& message) {
-    return makeHttpResponse(400, "Bad Request", "text/plain", message);
+    return makeHttpResponse(400, "text/plain", message);
 }
 
 std::string notFound(const std::string& message = "Not Found") {
-    return makeHttpResponse(404, "Not Found", "text/plain", message);
+    return makeHttpResponse(404, "text/plain", message);
+}
+
+// Answer to a request the parser rejected (400, 413, 431, 501 or 505)
+std::string requestError(int status, const std::string& message) {
+    return makeHttpResponse(status, "text/plain", message);
 }
 
-std::string options() {
-    return makeHttpResponse(200, "OK", "text/plain", "");
+const ResponseCache::Bytes& options() {
+    static const ResponseCache::Bytes response = fixedResponse(200, "text/plain", "");
+    return response;
+}
+
+// 304 for a conditional GET whose ETag still matches; no body, no Content-Length
+std::string notModified(const std::string& etag) {
+    constexpr std::string_view head = "HTTP/1.1 304 Not Modified\r\nAccess-Control-Allow-Origin: *\r\nETag: ";
+    std::string response;
+    response.reserve(head.size() + etag.size() + 4);
+    response += head;
+    response += etag;
+    response += "\r\n\r\n";
+    return response;
 }
 
 // Signal handler for graceful shutdown
-bool running = true;
+std::atomic<bool> running{true};  // Lock-free, so safe to clear from the handler
 void signalHandler(int signum) {
     std::cout << "Interrupt signal (" << signum << ") received.\n";
     running = false;
 }
 
-// Parse HTTP request
-struct HttpRequest {
-    std::string method;
-    std::string path;
-    std::string body;
-};
+// Request size limits; a body over MAX_BODY_SIZE is answered with 413
+constexpr std::size_t MAX_BODY_SIZE = 1 << 20;
+const HttpRequestLimits REQUEST_LIMITS{16 * 1024, 100, MAX_BODY_SIZE};
 
-HttpRequest parseRequest(const std::string& requestStr) {
-    HttpRequest request;
+// Input buffered per connection before reading stops: one full request plus slack
+constexpr std::size_t MAX_BUFFERED_INPUT = MAX_BODY_SIZE + 32 * 1024;
+
+// Parse path parameters
+std::string getPathParam(std::string_view path, std::string_view prefix) {
+    if (path.substr(0, prefix.size()) == prefix) {
+        std::string_view rest = path.substr(prefix.length());
+        // Remove trailing slash if present
+        if (!rest.empty() && rest.back() == '/') {
+            rest.remove_suffix(1);
+        }
+        return std::string(rest);
+    }
+    return "";
+}
+
+// Returns the decoded value of a query parameter, or an empty string when absent
+std::string getQueryParam(std::string_view query, std::string_view name) {
+    return HttpRequestParser::urlDecode(HttpRequestParser::queryParam(query, name));
+}
+
+// Fills `query` from the pagination/filter parameters of the list endpoints
+// (limit, after_id, difficulty, due_from, due_to). `paged` is left false when
+// none are given, so callers keep returning the full list. Returns an error
+// message for malformed values, or an empty string.
+std::string parseTaskQuery(std::string_view queryString, TaskQuery& query, bool& paged) {
+    std::string limit = getQueryParam(queryString, "limit");
+    std::string afterId = getQueryParam(queryString, "after_id");
+    std::string difficulty = getQueryParam(queryString, "difficulty");
+    query.dueFrom = getQueryParam(queryString, "due_from");
+    query.dueTo = getQueryParam(queryString, "due_to");
     
-    // Extract method and path
-    size_t methodEnd = requestStr.find(' ');
-    if (methodEnd != std::string::npos) {
-        request.method = requestStr.substr(0, methodEnd);
-        size_t pathEnd = requestStr.find(' ', methodEnd + 1);
-        if (pathEnd != std::string::npos) {
-            request.path = requestStr.substr(methodEnd + 1, pathEnd - methodEnd - 1);
+    paged = !limit.empty() || !afterId.empty() || !difficulty.empty() || !query.dueFrom.empty() || !query.dueTo.empty();
+    try {
+        if (!limit.empty()) {
+            query.limit = std::stoi(limit);
+        }
+        if (!afterId.empty()) {
+            query.afterId = std::stoi(afterId);
         }
+        if (!difficulty.empty()) {
+            query.difficulty = std::stoi(difficulty);
+        }
+    } catch (const std::exception&) {
+        return "limit, after_id and difficulty must be integers";
     }
     
-    // Extract body
-    size_t bodyStart = requestStr.find("\r\n\r\n");
-    if (bodyStart != std::string::npos) {
-        request.body = requestStr.substr(bodyStart + 4);
+    auto isDate = [](const std::string& d) { return epochDayFromDate(d) != NO_DUE_DAY; };
+    if ((!query.dueFrom.empty() && !isDate(query.dueFrom)) || (!query.dueTo.empty() && !isDate(query.dueTo))) {
+        return "due_from and due_to must be in YYYY-MM-DD format";
+    }
+    return "";
+}
+
+// Serves a list endpoint, paged when pagination/filter parameters are present
+std::string listTasksResponse(const ToDoList& todoList, std::string_view queryString, bool completed, const std::string& etag) {
+    TaskQuery query;
+    query.completed = completed;
+    bool paged = false;
+    std::string error = parseTaskQuery(queryString, query, paged);
+    if (!error.empty()) {
+        return badRequest(error);
+    }
+    if (!paged) {
+        return listResponse(todoList, completed, etag);
     }
     
-    return request;
+    return pageResponse(todoList.getTasksPage(query), etag);
 }
 
-// Parse path parameters
-std::string getPathParam(const std::string& path, const std::string& prefix) {
-    if (path.rfind(prefix, 0) == 0) {
-        std::string rest = path.substr(prefix.length());
-        // Remove trailing slash if present
-        if (!rest.empty() && rest.back() == '/') {
-            rest.pop_back();
-        }
-        return rest;
+// Fills `prioritizer` from ?strategy=, ?dueWeight= and ?difficultyWeight= (see
+// TaskPrioritizer::fromParameters). Returns an error message, or an empty string.
+std::string parsePrioritizer(std::string_view queryString, TaskPrioritizer& prioritizer) {
+    try {
+        prioritizer = TaskPrioritizer::fromParameters(getQueryParam(queryString, "strategy"),
+                                                      getQueryParam(queryString, "dueWeight"),
+                                                      getQueryParam(queryString, "difficultyWeight"));
+    } catch (const std::invalid_argument& e) {
+        return e.what();
     }
     return "";
 }
 
+// {"strategies":[{"id","key","name","description"[,"weights"]},...],"default":"balanced"}.
+// "key" is the value accepted by ?strategy= on /api/tasks/prioritized.
+std::string strategiesResponse() {
+    return okJsonResponse(512, "", [](JsonWriter& json) {
+        json.beginObject().key("strategies").beginArray();
+        for (auto strategy : TaskPrioritizer::allStrategies()) {
+            json.beginObject()
+                .key("id").value(static_cast<int>(strategy))
+                .key("key").value(TaskPrioritizer::strategyName(strategy))
+                .key("name").value(TaskPrioritizer::strategyTitle(strategy))
+                .key("description").value(TaskPrioritizer::strategyDescription(strategy));
+            if (strategy == TaskPrioritizer::Strategy::WEIGHTED) {
+                TaskPrioritizer::Weights defaults;
+                json.key("weights").beginObject()
+                    .key("dueWeight").value(defaults.dueDate)
+                    .key("difficultyWeight").value(defaults.difficulty)
+                    .endObject();
+            }
+            json.endObject();
+        }
+        json.endArray().key("default").value(TaskPrioritizer::strategyName(TaskPrioritizer::Strategy::BALANCED)).endObject();
+    });
+}
+
 int extractTaskId(const std::string& pathParam) {
     try {
         return std::stoi(pathParam);
@@ -150,339 +368,740 @@ int extractTaskId(const std::string& pathParam) {
     }
 }
 
-// Main application
-int main() {
-    // Register signal handler
-    signal(SIGINT, signalHandler);
-    
-    // Ensure data directory exists
-    std::filesystem::create_directories("data");
-
-    // Initialize database connection
-    ToDoList todoList;
-    try {
-        todoList.connect("data/tasks.db");
-        std::cout << "Connected to database successfully.\n";
-    } catch (const std::exception &e) {
-        std::cerr << "Database error: " << e.what() << std::endl;
-        return 1;
+// Validates the task object `json` is at and fills in `task`. Returns an error
+// message, or an empty string when the task is valid; malformed JSON throws.
+std::string parseTaskFields(JsonReader& json, Task& task) {
+    if (!json.task(task)) {
+        return "Missing required fields";
     }
-    
-    // Create socket
-    int serverSocket = socket(AF_INET, SOCK_STREAM, 0);
-    if (serverSocket < 0) {
-        std::cerr << "Error creating socket" << std::endl;
-        return 1;
+    if (task.difficulty < 1 || task.difficulty > 5) {
+        return "Difficulty must be between 1 and 5";
     }
-    
-    // Set socket options to reuse address
-    int opt = 1;
-    if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0) {
-        std::cerr << "Error setting socket options" << std::endl;
-        return 1;
+    if (!task.dueDate.empty() && (task.dueDate.length() != 10 || task.dueDate[4] != '-' || task.dueDate[7] != '-')) {
+        return "Due date must be in YYYY-MM-DD format";
     }
+    return "";
+}
+
+// A POST/PUT body holding one task object
+std::string parseTaskBody(std::string_view body, Task& task) {
+    JsonReader json(body);
+    std::string error = parseTaskFields(json, task);
+    if (error.empty()) {
+        json.end();
+    }
+    return error;
+}
+
+// Reads the tasks of a {"tasks":[{...},{...}]} body. Returns an error message, or an
+// empty string when every task is valid; malformed JSON throws.
+std::string parseTaskBatch(std::string_view body, std::vector<Task>& tasks) {
+    JsonReader json(body);
+    bool found = false;
+    json.beginObject();
+    std::string_view key;
+    while (json.nextMember(key)) {
+        if (key != "tasks" || json.peek() != JsonReader::Type::ARRAY) {
+            json.skipValue();
+            continue;
+        }
+        found = true;
+        tasks.clear();
+        json.beginArray();
+        while (json.nextElement()) {
+            std::string error = parseTaskFields(json, tasks.emplace_back());
+            if (!error.empty()) {
+                return "Task " + std::to_string(tasks.size() - 1) + ": " + error;
+            }
+        }
+    }
+    json.end();
+    return found ? "" : "Body must contain a \"tasks\" array";
+}
+
+// ResponseCache slots; PRIORITIZED_VIEW + strategy for each prioritization strategy
+enum : std::size_t { OPEN_VIEW, COMPLETED_VIEW, PRIORITIZED_VIEW };
+
+// A response: bytes built for this request, or shared bytes (a ResponseCache entry or
+// a fixed response) that are sent from where they live without being copied
+struct Reply {
+    std::string response;
+    ResponseCache::Bytes cached;
     
-    // Setup address struct
-    struct sockaddr_in serverAddr;
-    memset(&serverAddr, 0, sizeof(serverAddr));
-    serverAddr.sin_family = AF_INET;
-    serverAddr.sin_addr.s_addr = INADDR_ANY;
-    serverAddr.sin_port = htons(8080);
+    const std::string& bytes() const { return cached ? *cached : response; }
+};
+
+// Routes one request. Hot read views may answer with shared cached bytes instead
+// of building a response.
+Reply handleRequest(ToDoList& todoList, ResponseCache& responseCache, const HttpRequestView& request) {
+    Reply reply;
     
-    // Bind socket
-    if (bind(serverSocket, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
-        std::cerr << "Error binding socket" << std::endl;
-        return 1;
+    // Task reads are tagged with the data version, so a client that already has
+    // the current representation gets a 304 without a database query. The version
+    // is read first: a write landing before the ETag is taken only makes it newer.
+    std::uint64_t version = todoList.getDataVersion();
+    std::string etag;
+    if (request.method == "GET" && request.path.rfind("/api/tasks", 0) == 0) {
+        bool dated = getPathParam(request.path, "/api/tasks/") == "prioritized";
+        etag = dataETag(todoList, dated ? std::to_string(currentEpochDay()) : "");
     }
     
-    // Listen for connections
-    if (listen(serverSocket, 5) < 0) {
-        std::cerr << "Error listening" << std::endl;
-        return 1;
+    if (!etag.empty() && etagMatches(request.header("If-None-Match"), etag)) {
+        reply.response = notModified(etag);
     }
-    
-    std::cout << "Starting API server on http://localhost:8080\n";
-    
-    // Main loop
-    while (running) {
-        // Accept connection
-        struct sockaddr_in clientAddr;
-        socklen_t clientAddrLen = sizeof(clientAddr);
-        int clientSocket = accept(serverSocket, (struct sockaddr*)&clientAddr, &clientAddrLen);
-        
-        if (clientSocket < 0) {
-            if (running) {
-                std::cerr << "Error accepting connection" << std::endl;
+    // Health endpoint
+    else if (request.path == "/health" && request.method == "GET") {
+        reply.response = okJsonResponse(48, "", [](JsonWriter& json) {
+            json.beginObject().key("status").value("ok")
+                .key("timestamp").value(static_cast<long long>(std::time(nullptr))).endObject();
+        });
+    }
+    // Handle OPTIONS requests
+    else if (request.method == "OPTIONS") {
+        reply.cached = options();
+    }
+    // Available prioritization strategies
+    else if (request.path == "/api/prioritization/strategies" && request.method == "GET") {
+        reply.response = strategiesResponse();
+    }
+    // Get all tasks
+    else if (request.path == "/api/tasks" && request.method == "GET") {
+        try {
+            if (request.query.empty()) {
+                reply.cached = responseCache.getOrBuild(OPEN_VIEW, version, etag, [&] {
+                    return listResponse(todoList, false, etag);
+                });
+            } else {
+                reply.response = listTasksResponse(todoList, request.query, false, etag);
             }
-            continue;
-        }
-        
-        // Read request
-        char buffer[4096] = {0};
-        ssize_t bytesRead = read(clientSocket, buffer, sizeof(buffer) - 1);
-        
-        if (bytesRead <= 0) {
-            close(clientSocket);
-            continue;
+        } catch (const std::exception& e) {
+            reply.response = badRequest(e.what());
         }
+    }
+    // Get a single task
+    else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "GET") {
+        // Extract task ID
+        std::string pathParam = getPathParam(request.path, "/api/tasks/");
         
-        // Parse request
-        std::string requestStr(buffer);
-        HttpRequest request = parseRequest(requestStr);
-        
-        // Process request
-        std::string response;
-        
-        // Health endpoint
-        if (request.path == "/health" && request.method == "GET") {
-            std::ostringstream health;
-            health << "{\"status\":\"ok\",\"timestamp\":" << std::time(nullptr) << "}";
-            response = okJson(health.str());
-        }
-        // Handle OPTIONS requests
-        else if (request.method == "OPTIONS") {
-            response = options();
-        }
-        // Get all tasks
-        else if (request.path == "/api/tasks" && request.method == "GET") {
+        // Check for special paths
+        if (pathParam == "completed") {
             try {
-                auto tasks = todoList.getTasks();
-                response = okJson(tasksToJson(tasks));
+                if (request.query.empty()) {
+                    reply.cached = responseCache.getOrBuild(COMPLETED_VIEW, version, etag, [&] {
+                        return listResponse(todoList, true, etag);
+                    });
+                } else {
+                    reply.response = listTasksResponse(todoList, request.query, true, etag);
+                }
             } catch (const std::exception& e) {
-                response = badRequest(e.what());
+                reply.response = badRequest(e.what());
             }
-        }
-        // Get a single task
-        else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "GET") {
-            // Extract task ID
-            std::string pathParam = getPathParam(request.path, "/api/tasks/");
-            
-            // Check for special paths
-            if (pathParam == "completed") {
-                try {
-                    auto tasks = todoList.getCompletedTasks();
-                    response = okJson(tasksToJson(tasks));
-                } catch (const std::exception& e) {
-                    response = badRequest(e.what());
-                }
-            } else if (pathParam == "prioritized") {
-                try {
-                    auto tasks = todoList.getPrioritizedTasks();
-                    response = okJson(tasksToJson(tasks));
-                } catch (const std::exception& e) {
-                    response = badRequest(e.what());
+        } else if (pathParam == "search") {
+            try {
+                // ?q=words, optional ?limit=N up to 100 (default 20)
+                std::string text = getQueryParam(request.query, "q");
+                std::string limitParam = getQueryParam(request.query, "limit");
+                int limit = 20;
+                if (!limitParam.empty()) {
+                    try {
+                        limit = std::stoi(limitParam);
+                    } catch (const std::exception&) {
+                        limit = 0;
+                    }
                 }
-            } else {
-                int taskId = extractTaskId(pathParam);
-                if (taskId < 0) {
-                    response = badRequest("Invalid task ID");
+                if (text.empty()) {
+                    reply.response = badRequest("q is required");
+                } else if (limit < 1 || limit > 100) {
+                    reply.response = badRequest("limit must be between 1 and 100");
                 } else {
-                    auto tasks = todoList.getTasks();
-                    bool found = false;
-                    
-                    for (const auto& task : tasks) {
-                        if (task.id == taskId) {
-                            response = okJson(taskToJson(task));
-                            found = true;
-                            break;
-                        }
-                    }
-                    
-                    if (!found) {
-                        response = notFound("Task not found");
-                    }
+                    reply.response = tasksResponse(todoList.searchTasks(text, static_cast<size_t>(limit)), etag);
                 }
+            } catch (const std::exception& e) {
+                reply.response = badRequest(e.what());
             }
-        }
-        // Add a new task
-        else if (request.path == "/api/tasks" && request.method == "POST") {
-            // Parse JSON body
+        } else if (pathParam == "suggest") {
             try {
-                // Very basic JSON parsing - in a real app, use a proper JSON library
-                size_t headerPos = request.body.find("\"header\":");
-                size_t difficultyPos = request.body.find("\"difficulty\":");
-                
-                if (headerPos == std::string::npos || difficultyPos == std::string::npos) {
-                    response = badRequest("Missing required fields");
-                } else {
-                    // Extract header
-                    size_t headerStart = request.body.find("\"", headerPos + 9) + 1;
-                    size_t headerEnd = request.body.find("\"", headerStart);
-                    std::string header = request.body.substr(headerStart, headerEnd - headerStart);
-                    
-                    // Extract difficulty
-                    size_t difficultyStart = difficultyPos + 13;
-                    size_t difficultyEnd = request.body.find(",", difficultyStart);
-                    if (difficultyEnd == std::string::npos) {
-                        difficultyEnd = request.body.find("}", difficultyStart);
+                // ?prefix=text, optional ?limit=N up to 50 (default 10)
+                std::string limitParam = getQueryParam(request.query, "limit");
+                int limit = 10;
+                if (!limitParam.empty()) {
+                    try {
+                        limit = std::stoi(limitParam);
+                    } catch (const std::exception&) {
+                        limit = 0;
                     }
-                    std::string difficultyStr = request.body.substr(difficultyStart, difficultyEnd - difficultyStart);
-                    int difficulty = std::stoi(difficultyStr);
-                    
-                    // Validate difficulty
-                    if (difficulty < 1 || difficulty > 5) {
-                        response = badRequest("Difficulty must be between 1 and 5");
-                    } else {
-                        // Extract description (optional)
-                        std::string description;
-                        size_t descriptionPos = request.body.find("\"description\":");
-                        if (descriptionPos != std::string::npos) {
-                            size_t descriptionStart = request.body.find("\"", descriptionPos + 14) + 1;
-                            size_t descriptionEnd = request.body.find("\"", descriptionStart);
-                            description = request.body.substr(descriptionStart, descriptionEnd - descriptionStart);
-                        }
-                        
-                        // Extract due date (optional)
-                        std::string dueDate;
-                        size_t dueDatePos = request.body.find("\"dueDate\":");
-                        if (dueDatePos != std::string::npos) {
-                            size_t dueDateStart = request.body.find("\"", dueDatePos + 10) + 1;
-                            size_t dueDateEnd = request.body.find("\"", dueDateStart);
-                            dueDate = request.body.substr(dueDateStart, dueDateEnd - dueDateStart);
-                            
-                            // Validate date format
-                            if (!dueDate.empty() && (dueDate.length() != 10 || dueDate[4] != '-' || dueDate[7] != '-')) {
-                                response = badRequest("Due date must be in YYYY-MM-DD format");
-                                dueDate = "";
-                            }
-                        }
-                        
-                        if (response.empty()) {
-                            todoList.addTask(header, description, difficulty, dueDate);
-                            response = created();
+                }
+                if (limit < 1 || limit > 50) {
+                    reply.response = badRequest("limit must be between 1 and 50");
+                } else {
+                    auto suggestions = todoList.suggestHeaders(getQueryParam(request.query, "prefix"), static_cast<size_t>(limit));
+                    reply.response = okJsonResponse(64 * suggestions.size() + 32, etag, [&suggestions](JsonWriter& json) {
+                        json.beginObject().key("suggestions").beginArray();
+                        for (const auto& suggestion : suggestions) {
+                            json.beginObject().key("header").value(suggestion.header).key("count").value(suggestion.count).endObject();
                         }
-                    }
+                        json.endArray().endObject();
+                    });
                 }
             } catch (const std::exception& e) {
-                response = badRequest(e.what());
+                reply.response = badRequest(e.what());
             }
-        }
-        // Mark task as complete
-        else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "POST") {
-            std::string pathParam = getPathParam(request.path, "/api/tasks/");
-            size_t slashPos = pathParam.find('/');
-            
-            if (slashPos != std::string::npos) {
-                std::string taskIdStr = pathParam.substr(0, slashPos);
-                std::string action = pathParam.substr(slashPos + 1);
-                
-                int taskId = extractTaskId(taskIdStr);
-                if (taskId < 0) {
-                    response = badRequest("Invalid task ID");
+        } else if (pathParam == "prioritized") {
+            try {
+                // Optional ?limit=N returns only the N most urgent tasks
+                std::string limitParam = getQueryParam(request.query, "limit");
+                int limit = 0;
+                if (!limitParam.empty()) {
+                    try {
+                        limit = std::stoi(limitParam);
+                    } catch (const std::exception&) {
+                        limit = -1;
+                    }
+                }
+                // Optional ?strategy=<name> (see /api/prioritization/strategies)
+                TaskPrioritizer prioritizer;
+                std::string error = parsePrioritizer(request.query, prioritizer);
+                if (limit < 0 || (!limitParam.empty() && limit == 0)) {
+                    reply.response = badRequest("limit must be a positive integer");
+                } else if (!error.empty()) {
+                    reply.response = badRequest(error);
                 } else {
-                    if (action == "complete") {
-                        bool marked = todoList.markTaskAsCompleted(taskId);
-                        response = marked ? okJson("{}") : notFound("Task not found");
-                    } else if (action == "uncomplete") {
-                        bool unmarked = todoList.unmarkTaskAsCompleted(taskId);
-                        response = unmarked ? okJson("{}") : notFound("Task not found");
+                    auto build = [&] {
+                        return tasksResponse(todoList.getPrioritizedTasks(prioritizer, static_cast<size_t>(limit)), etag);
+                    };
+                    // The full order for a strategy's default weights is a shared view
+                    bool defaultView = limitParam.empty() && getQueryParam(request.query, "dueWeight").empty() &&
+                                       getQueryParam(request.query, "difficultyWeight").empty();
+                    if (defaultView) {
+                        reply.cached = responseCache.getOrBuild(
+                            PRIORITIZED_VIEW + static_cast<std::size_t>(prioritizer.getStrategy()), version, etag, build);
                     } else {
-                        response = notFound("Unknown action");
+                        reply.response = build();
                     }
                 }
-            } else {
-                response = badRequest("Invalid path");
+            } catch (const std::exception& e) {
+                reply.response = badRequest(e.what());
             }
-        }
-        // Delete a task
-        else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "DELETE") {
-            std::string pathParam = getPathParam(request.path, "/api/tasks/");
+        } else {
             int taskId = extractTaskId(pathParam);
-            
             if (taskId < 0) {
-                response = badRequest("Invalid task ID");
+                reply.response = badRequest("Invalid task ID");
             } else {
                 try {
-                    todoList.deleteTask(taskId);
-                    response = noContent();
+                    auto task = todoList.getTaskById(taskId);
+                    reply.response = task ? okJsonResponse(JsonWriter::estimateTaskSize(*task), etag, [&task](JsonWriter& json) {
+                        json.task(*task);
+                    }) : notFound("Task not found");
                 } catch (const std::exception& e) {
-                    response = badRequest(e.what());
+                    reply.response = badRequest(e.what());
                 }
             }
         }
-        // Update a task
-        else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "PUT") {
-            std::string pathParam = getPathParam(request.path, "/api/tasks/");
-            int taskId = extractTaskId(pathParam);
+    }
+    // Add several tasks in one transaction
+    else if (request.path == "/api/tasks/batch" && request.method == "POST") {
+        try {
+            std::vector<Task> tasks;
+            std::string error = parseTaskBatch(request.body, tasks);
+            if (!error.empty()) {
+                reply.response = badRequest(error);
+            } else {
+                auto ids = todoList.addTasks(tasks);
+                reply.response = jsonResponse(201, 12 * ids.size() + 16, "", [&ids](JsonWriter& json) {
+                    json.beginObject().key("ids").beginArray();
+                    for (int id : ids) {
+                        json.value(id);
+                    }
+                    json.endArray().endObject();
+                });
+            }
+        } catch (const std::exception& e) {
+            reply.response = badRequest(e.what());
+        }
+    }
+    // Add a new task
+    else if (request.path == "/api/tasks" && request.method == "POST") {
+        try {
+            Task task;
+            std::string error = parseTaskBody(request.body, task);
+            if (!error.empty()) {
+                reply.response = badRequest(error);
+            } else {
+                todoList.addTask(task.header, task.description, task.difficulty, task.dueDate);
+                reply.cached = created();
+            }
+        } catch (const std::exception& e) {
+            reply.response = badRequest(e.what());
+        }
+    }
+    // Mark task as complete
+    else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "POST") {
+        std::string pathParam = getPathParam(request.path, "/api/tasks/");
+        size_t slashPos = pathParam.find('/');
+        
+        if (slashPos != std::string::npos) {
+            std::string taskIdStr = pathParam.substr(0, slashPos);
+            std::string action = pathParam.substr(slashPos + 1);
             
+            int taskId = extractTaskId(taskIdStr);
             if (taskId < 0) {
-                response = badRequest("Invalid task ID");
+                reply.response = badRequest("Invalid task ID");
             } else {
                 try {
-                    // Parse JSON body - simplified for brevity
-                    size_t headerPos = request.body.find("\"header\":");
-                    size_t difficultyPos = request.body.find("\"difficulty\":");
-                    
-                    if (headerPos == std::string::npos || difficultyPos == std::string::npos) {
-                        response = badRequest("Missing required fields");
-                    } else {
-                        // Extract header
-                        size_t headerStart = request.body.find("\"", headerPos + 9) + 1;
-                        size_t headerEnd = request.body.find("\"", headerStart);
-                        std::string header = request.body.substr(headerStart, headerEnd - headerStart);
-                        
-                        // Extract difficulty
-                        size_t difficultyStart = difficultyPos + 13;
-                        size_t difficultyEnd = request.body.find(",", difficultyStart);
-                        if (difficultyEnd == std::string::npos) {
-                            difficultyEnd = request.body.find("}", difficultyStart);
+                    if (action == "complete") {
+                        bool marked = todoList.markTaskAsCompleted(taskId);
+                        if (marked) {
+                            reply.cached = okEmptyJson();
+                        } else {
+                            reply.response = notFound("Task not found");
                         }
-                        std::string difficultyStr = request.body.substr(difficultyStart, difficultyEnd - difficultyStart);
-                        int difficulty = std::stoi(difficultyStr);
-                        
-                        // Validate difficulty
-                        if (difficulty < 1 || difficulty > 5) {
-                            response = badRequest("Difficulty must be between 1 and 5");
+                    } else if (action == "uncomplete") {
+                        bool unmarked = todoList.unmarkTaskAsCompleted(taskId);
+                        if (unmarked) {
+                            reply.cached = okEmptyJson();
                         } else {
-                            // Extract description (optional)
-                            std::string description;
-                            size_t descriptionPos = request.body.find("\"description\":");
-                            if (descriptionPos != std::string::npos) {
-                                size_t descriptionStart = request.body.find("\"", descriptionPos + 14) + 1;
-                                size_t descriptionEnd = request.body.find("\"", descriptionStart);
-                                description = request.body.substr(descriptionStart, descriptionEnd - descriptionStart);
-                            }
-                            
-                            // Extract due date (optional)
-                            std::string dueDate;
-                            size_t dueDatePos = request.body.find("\"dueDate\":");
-                            if (dueDatePos != std::string::npos) {
-                                size_t dueDateStart = request.body.find("\"", dueDatePos + 10) + 1;
-                                size_t dueDateEnd = request.body.find("\"", dueDateStart);
-                                dueDate = request.body.substr(dueDateStart, dueDateEnd - dueDateStart);
-                                
-                                // Validate date format
-                                if (!dueDate.empty() && (dueDate.length() != 10 || dueDate[4] != '-' || dueDate[7] != '-')) {
-                                    response = badRequest("Due date must be in YYYY-MM-DD format");
-                                    dueDate = "";
-                                }
-                            }
-                            
-                            if (response.empty()) {
-                                todoList.editTask(taskId, header, description, difficulty, dueDate);
-                                response = okJson("{}");
-                            }
+                            reply.response = notFound("Task not found");
                         }
+                    } else {
+                        reply.response = notFound("Unknown action");
                     }
                 } catch (const std::exception& e) {
-                    response = badRequest(e.what());
+                    reply.response = badRequest(e.what());
+                }
+            }
+        } else {
+            reply.response = badRequest("Invalid path");
+        }
+    }
+    // Delete a task
+    else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "DELETE") {
+        std::string pathParam = getPathParam(request.path, "/api/tasks/");
+        int taskId = extractTaskId(pathParam);
+        
+        if (taskId < 0) {
+            reply.response = badRequest("Invalid task ID");
+        } else {
+            try {
+                todoList.deleteTask(taskId);
+                reply.cached = noContent();
+            } catch (const std::exception& e) {
+                reply.response = badRequest(e.what());
+            }
+        }
+    }
+    // Update a task
+    else if (request.path.rfind("/api/tasks/", 0) == 0 && request.method == "PUT") {
+        std::string pathParam = getPathParam(request.path, "/api/tasks/");
+        int taskId = extractTaskId(pathParam);
+        
+        if (taskId < 0) {
+            reply.response = badRequest("Invalid task ID");
+        } else {
+            try {
+                Task task;
+                std::string error = parseTaskBody(request.body, task);
+                if (!error.empty()) {
+                    reply.response = badRequest(error);
+                } else {
+                    todoList.editTask(taskId, task.header, task.description, task.difficulty, task.dueDate);
+                    reply.cached = okEmptyJson();
+                }
+            } catch (const std::exception& e) {
+                reply.response = badRequest(e.what());
+            }
+        }
+    }
+    // Catch-all for unknown routes
+    else {
+        reply.response = notFound("Endpoint not found");
+    }
+    return reply;
+}
+
+// Keep-alive connections idle this long are closed; so are connections that take
+// longer than REQUEST_TIMEOUT to send a request or to take a response
+constexpr std::chrono::seconds KEEP_ALIVE_TIMEOUT(5);
+constexpr std::chrono::seconds REQUEST_TIMEOUT(10);
+
+// Replies queued ahead of a pipelining client; its further requests stay unparsed
+// until the queue drains
+constexpr std::size_t MAX_QUEUED_REPLIES = 32;
+
+// One client connection of the event loop
+struct Connection {
+    int fd = -1;
+    std::string input;               // Received bytes not yet handled
+    HttpRequestParser parser{REQUEST_LIMITS};  // Progress through the request at the front of input
+    std::deque<Reply> output;        // Replies in request order, the front one partly sent
+    std::size_t sent = 0;            // Bytes of output.front() already written
+    bool closeAfterReplies = false;  // The client asked to close, or sent a bad request
+    bool peerClosed = false;         // No more input will arrive
+    std::uint32_t watched = EPOLLIN | EPOLLRDHUP;  // Current epoll interest
+    std::chrono::steady_clock::time_point lastActivity;
+};
+
+// Accepts every pending connection as a non-blocking socket watched for input
+void acceptConnections(int serverSocket, int epollFd, std::unordered_map<int, Connection>& connections,
+                       std::chrono::steady_clock::time_point now) {
+    for (;;) {
+        int fd = accept4(serverSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                std::cerr << "Error accepting connection: " << std::strerror(errno) << std::endl;
+            }
+            return;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP;
+        event.data.fd = fd;
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        Connection& conn = connections[fd];
+        conn.fd = fd;
+        conn.lastActivity = now;
+    }
+}
+
+// Answers the complete requests buffered on the connection, in order, while the
+// reply queue has room
+void handleRequests(Connection& conn, ToDoList& todoList, ResponseCache& responseCache) {
+    std::size_t consumed = 0;
+    while (!conn.closeAfterReplies && conn.output.size() < MAX_QUEUED_REPLIES) {
+        std::string_view pending(conn.input.data() + consumed, conn.input.size() - consumed);
+        HttpRequestParser::Status status = conn.parser.parse(pending);
+        if (status == HttpRequestParser::Status::INCOMPLETE) {
+            // Chunk framing can make the raw bytes outgrow the decoded body limit
+            if (pending.size() > MAX_BUFFERED_INPUT) {
+                conn.output.push_back({requestError(413, "Request too large"), nullptr});
+                conn.closeAfterReplies = true;
+            }
+            break;
+        }
+        if (status == HttpRequestParser::Status::FAILED) {
+            conn.output.push_back({requestError(conn.parser.errorStatus(), conn.parser.errorMessage()), nullptr});
+            conn.closeAfterReplies = true;
+            break;
+        }
+        const HttpRequestView& request = conn.parser.request();
+        conn.closeAfterReplies = !request.keepAlive();
+        conn.output.push_back(handleRequest(todoList, responseCache, request));
+        consumed += conn.parser.consumed();
+        conn.parser.reset();
+    }
+    conn.input.erase(0, consumed);
+}
+
+// Queued replies handed to the kernel per system call
+constexpr std::size_t MAX_GATHERED_REPLIES = 64;
+
+// Writes queued replies until done or the socket buffer is full, gathering several
+// into each sendmsg (writev with MSG_NOSIGNAL) so pipelined replies share a system
+// call. Returns false on a write error.
+bool sendReplies(Connection& conn, std::chrono::steady_clock::time_point now) {
+    iovec iov[MAX_GATHERED_REPLIES];
+    while (!conn.output.empty()) {
+        std::size_t count = 0;
+        std::size_t skip = conn.sent;
+        for (auto it = conn.output.begin(); it != conn.output.end() && count < MAX_GATHERED_REPLIES; ++it) {
+            const std::string& bytes = it->bytes();
+            iov[count].iov_base = const_cast<char*>(bytes.data() + skip);
+            iov[count].iov_len = bytes.size() - skip;
+            skip = 0;
+            ++count;
+        }
+        msghdr message{};
+        message.msg_iov = iov;
+        message.msg_iovlen = count;
+        ssize_t written = sendmsg(conn.fd, &message, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno == EAGAIN || errno == EWOULDBLOCK;
+        }
+        conn.lastActivity = now;
+        
+        // Drop the replies written in full; a short write leaves the rest of the
+        // front reply for the next call
+        std::size_t remaining = static_cast<std::size_t>(written);
+        while (remaining > 0) {
+            std::size_t left = conn.output.front().bytes().size() - conn.sent;
+            if (remaining < left) {
+                conn.sent += remaining;
+                break;
+            }
+            remaining -= left;
+            conn.output.pop_front();
+            conn.sent = 0;
+        }
+    }
+    return true;
+}
+
+// Handles readiness on a client socket: reads what arrived, answers complete
+// requests and writes replies. Returns false when the connection should be closed.
+bool serviceConnection(Connection& conn, std::uint32_t events, int epollFd, ToDoList& todoList,
+                       ResponseCache& responseCache, std::chrono::steady_clock::time_point now) {
+    if (events & EPOLLERR) {
+        return false;
+    }
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) {
+        char buffer[16384];
+        for (;;) {
+            ssize_t bytesRead = recv(conn.fd, buffer, sizeof(buffer), 0);
+            if (bytesRead > 0) {
+                conn.input.append(buffer, static_cast<std::size_t>(bytesRead));
+                conn.lastActivity = now;
+                if (conn.input.size() > MAX_BUFFERED_INPUT) {
+                    break;  // Enough to answer 413
                 }
+            } else if (bytesRead == 0) {
+                conn.peerClosed = true;
+                break;
+            } else if (errno == EINTR) {
+                continue;
+            } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            } else {
+                return false;
             }
         }
-        // Catch-all for unknown routes
-        else {
-            response = notFound("Endpoint not found");
+    }
+    
+    // Alternate answering and writing, so a pipelined burst larger than the reply
+    // queue is still worked through
+    for (;;) {
+        std::size_t unhandled = conn.input.size();
+        handleRequests(conn, todoList, responseCache);
+        if (!sendReplies(conn, now)) {
+            return false;
+        }
+        if (!conn.output.empty() || conn.input.size() == unhandled || conn.closeAfterReplies) {
+            break;
+        }
+    }
+    
+    if (conn.output.empty() && (conn.closeAfterReplies || conn.peerClosed)) {
+        return false;
+    }
+    
+    // Read only while there is room to answer (backpressure on clients that pipeline
+    // without reading); watch for writability only while replies wait on a full buffer
+    bool wantRead = !conn.peerClosed && !conn.closeAfterReplies && conn.output.size() < MAX_QUEUED_REPLIES &&
+                    conn.input.size() <= MAX_BUFFERED_INPUT;
+    std::uint32_t interest = (wantRead ? EPOLLIN | EPOLLRDHUP : 0u) | (conn.output.empty() ? 0u : EPOLLOUT);
+    if (interest != conn.watched) {
+        epoll_event event{};
+        event.events = interest;
+        event.data.fd = conn.fd;
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, conn.fd, &event);
+        conn.watched = interest;
+    }
+    return true;
+}
+
+// One worker's event loop, serving the connections accepted on its own listening
+// socket until shutdown. All workers share the ToDoList (which gives each reading
+// thread its own SQLite connection and serializes writes) and the response cache.
+void runEventLoop(int serverSocket, ToDoList& todoList, ResponseCache& responseCache) {
+    int epollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listenEvent{};
+    listenEvent.events = EPOLLIN;
+    listenEvent.data.fd = serverSocket;
+    if (epollFd < 0 || epoll_ctl(epollFd, EPOLL_CTL_ADD, serverSocket, &listenEvent) < 0) {
+        std::cerr << "Error setting up epoll" << std::endl;
+        running = false;
+        return;
+    }
+    
+    // Non-blocking sockets, many keep-alive connections
+    std::unordered_map<int, Connection> connections;
+    auto closeConnection = [&connections](int fd) {
+        close(fd);  // Also removes it from the epoll set
+        connections.erase(fd);
+    };
+    auto lastSweep = std::chrono::steady_clock::now();
+    std::vector<epoll_event> events(256);
+    
+    while (running) {
+        int ready = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 1000);
+        if (ready < 0 && errno != EINTR) {
+            std::cerr << "epoll_wait failed: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        auto now = std::chrono::steady_clock::now();
+        
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == serverSocket) {
+                acceptConnections(serverSocket, epollFd, connections, now);
+                continue;
+            }
+            auto found = connections.find(fd);
+            if (found == connections.end()) {
+                continue;
+            }
+            if (!serviceConnection(found->second, events[i].events, epollFd, todoList, responseCache, now)) {
+                closeConnection(fd);
+            }
         }
         
-        // Send response
-        write(clientSocket, response.c_str(), response.length());
+        // Once a second, drop idle keep-alive connections and stalled clients
+        if (now - lastSweep >= std::chrono::seconds(1)) {
+            lastSweep = now;
+            std::vector<int> expired;
+            for (const auto& entry : connections) {
+                const Connection& conn = entry.second;
+                bool busy = !conn.input.empty() || !conn.output.empty();
+                if (now - conn.lastActivity > (busy ? REQUEST_TIMEOUT : KEEP_ALIVE_TIMEOUT)) {
+                    expired.push_back(entry.first);
+                }
+            }
+            for (int fd : expired) {
+                closeConnection(fd);
+            }
+        }
+    }
+    
+    for (const auto& entry : connections) {
+        close(entry.first);
+    }
+    close(epollFd);
+}
+
+// Opens a non-blocking listening socket on `port`. With SO_REUSEPORT several workers
+// each bind their own socket to the same port and the kernel spreads connections
+// across them. Returns -1 on failure.
+int openListener(std::uint16_t port) {
+    int serverSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (serverSocket < 0) {
+        std::cerr << "Error creating socket" << std::endl;
+        return -1;
+    }
+    
+    // Set socket options to reuse address and share the port between workers
+    int opt = 1;
+    if (setsockopt(serverSocket, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt)) < 0 ||
+        setsockopt(serverSocket, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        std::cerr << "Error setting socket options" << std::endl;
+        close(serverSocket);
+        return -1;
+    }
+    
+    // Setup address struct
+    struct sockaddr_in serverAddr;
+    memset(&serverAddr, 0, sizeof(serverAddr));
+    serverAddr.sin_family = AF_INET;
+    serverAddr.sin_addr.s_addr = INADDR_ANY;
+    serverAddr.sin_port = htons(port);
+    
+    // Bind socket
+    if (bind(serverSocket, (struct sockaddr*)&serverAddr, sizeof(serverAddr)) < 0) {
+        std::cerr << "Error binding socket" << std::endl;
+        close(serverSocket);
+        return -1;
+    }
+    
+    // Listen for connections
+    if (listen(serverSocket, SOMAXCONN) < 0) {
+        std::cerr << "Error listening" << std::endl;
+        close(serverSocket);
+        return -1;
+    }
+    return serverSocket;
+}
+
+// Number of workers, from TODO_API_THREADS (defaults to one per core)
+unsigned configuredWorkerCount() {
+    if (const char* env = std::getenv("TODO_API_THREADS")) {
+        try {
+            unsigned long count = std::stoul(env);
+            if (count > 0) {
+                return static_cast<unsigned>(count);
+            }
+        } catch (const std::exception&) {
+        }
+        std::cerr << "Ignoring invalid TODO_API_THREADS value: " << env << std::endl;
+    }
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// Main application
+int main() {
+    // Register signal handler
+    signal(SIGINT, signalHandler);
+    
+    // Ensure data directory exists
+    std::filesystem::create_directories("data");
+
+    // Initialize database connection
+    ToDoList todoList;
+    try {
+        todoList.connect("data/tasks.db");
+        std::cout << "Connected to database successfully.\n";
         
-        // Close connection
-        close(clientSocket);
+        // TODO_PRIORITY_ENGINE=sql orders prioritized tasks in SQLite instead of in memory
+        const char* engine = std::getenv("TODO_PRIORITY_ENGINE");
+        if (engine && std::string(engine) == "sql") {
+            todoList.setPriorityEngine(ToDoList::PriorityEngine::SQL);
+        }
+    } catch (const std::exception &e) {
+        std::cerr << "Database error: " << e.what() << std::endl;
+        return 1;
+    }
+    
+    // With several workers, writes arriving together can share one transaction; each
+    // writing worker still waits for its own commit. Writes run on the worker's event
+    // loop, so while one waits (up to the window, plus the commit) every other connection
+    // of that worker waits too: group commit trades that latency for fewer fsyncs and
+    // only pays off when writes are frequent enough to fill batches.
+    unsigned workerCount = configuredWorkerCount();
+    GroupCommitOptions groupCommit = GroupCommitOptions::fromEnvironment();
+    if (groupCommit.enabled && workerCount > 1) {
+        groupCommit.maxBatch = workerCount;
+        todoList.setGroupCommit(groupCommit);
+    }
+    
+    // Complete responses for the unfiltered open/completed lists and each strategy's
+    // full prioritized order, rebuilt only after the data version changes
+    ResponseCache responseCache(PRIORITIZED_VIEW + TaskPrioritizer::allStrategies().size());
+    
+    // Every worker listens on its own socket, so accepting never contends
+    std::vector<int> listeners;
+    for (unsigned i = 0; i < workerCount; ++i) {
+        int serverSocket = openListener(8080);
+        if (serverSocket < 0) {
+            for (int fd : listeners) {
+                close(fd);
+            }
+            return 1;
+        }
+        listeners.push_back(serverSocket);
+    }
+    
+    std::cout << "Starting API server on http://localhost:8080 with " << workerCount << " worker(s)\n";
+    
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < listeners.size(); ++i) {
+        workers.emplace_back(runEventLoop, listeners[i], std::ref(todoList), std::ref(responseCache));
+    }
+    runEventLoop(listeners[0], todoList, responseCache);
+    for (auto& worker : workers) {
+        worker.join();
     }
     
     // Cleanup
-    close(serverSocket);
+    for (int fd : listeners) {
+        close(fd);
+    }
     
     return 0;
-} 
\ No newline at end of file
+}
@@ -2,6 +2,9 @@
 #include "TaskPrioritizer.h"
 #include <gtest/gtest.h>
 #include <filesystem>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
 
 class ToDoListTest : public ::testing::Test {
 protected:
@@ -12,14 +15,28 @@ protected:
     }
     
     void TearDown() override {
-        // Remove test database
+        // Remove test database (and its WAL side files)
         std::filesystem::remove(dbPath);
+        std::filesystem::remove(dbPath + "-wal");
+        std::filesystem::remove(dbPath + "-shm");
     }
     
     ToDoList todoList;
     std::string dbPath;
 };
 
+// Drops the dueDay column behind the ToDoList's back: plain UPDATEs still succeed,
+// but re-reading a task row (the index refresh after unmarking) then fails
+static void dropDueDayColumn(const std::string& path) {
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(path.c_str(), &raw));
+    EXPECT_EQ(SQLITE_OK, sqlite3_exec(raw,
+        "DROP INDEX idx_tasks_completed_due_first;"
+        "DROP INDEX idx_tasks_completed_difficulty;"
+        "ALTER TABLE tasks DROP COLUMN dueDay;", nullptr, nullptr, nullptr));
+    sqlite3_close(raw);
+}
+
 TEST_F(ToDoListTest, AddAndRetrieveTask) {
     todoList.addTask("Test Task", "Description", 3, "2023-12-31");
     auto tasks = todoList.getTasks();
@@ -30,4 +47,507 @@ TEST_F(ToDoListTest, AddAndRetrieveTask) {
     EXPECT_EQ(3, tasks[0].difficulty);
     EXPECT_EQ("2023-12-31", tasks[0].dueDate);
     EXPECT_FALSE(tasks[0].completed);
-}
\ No newline at end of file
+}
+
+TEST_F(ToDoListTest, GetTaskByIdFindsOpenAndCompletedTasks) {
+    todoList.addTask("Open Task", "Still to do", 2, "2024-01-10");
+    todoList.addTask("Done Task", "Already finished", 4, "");
+    auto tasks = todoList.getTasks();
+    ASSERT_EQ(2, tasks.size());
+    int openId = tasks[0].id;
+    int doneId = tasks[1].id;
+    ASSERT_TRUE(todoList.markTaskAsCompleted(doneId));
+    
+    auto open = todoList.getTaskById(openId);
+    ASSERT_TRUE(open.has_value());
+    EXPECT_EQ("Open Task", open->header);
+    EXPECT_FALSE(open->completed);
+    
+    auto done = todoList.getTaskById(doneId);
+    ASSERT_TRUE(done.has_value());
+    EXPECT_EQ("Done Task", done->header);
+    EXPECT_TRUE(done->completed);
+    
+    EXPECT_FALSE(todoList.getTaskById(doneId + 100).has_value());
+}
+
+TEST_F(ToDoListTest, GetTasksByIdsKeepsRequestOrder) {
+    todoList.addTask("First", "", 1, "");
+    todoList.addTask("Second", "", 2, "");
+    auto tasks = todoList.getTasks();
+    ASSERT_EQ(2, tasks.size());
+    
+    auto found = todoList.getTasksByIds({tasks[1].id, 9999, tasks[0].id});
+    ASSERT_EQ(2, found.size());
+    EXPECT_EQ("Second", found[0].header);
+    EXPECT_EQ("First", found[1].header);
+}
+
+TEST(ToDoListMigrationTest, UpgradesUnversionedDatabaseInPlace) {
+    const std::string legacyPath = "test_legacy_tasks.db";
+    std::filesystem::remove(legacyPath);
+    
+    // Database as created before schema versioning existed
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(legacyPath.c_str(), &raw));
+    ASSERT_EQ(SQLITE_OK, sqlite3_exec(raw,
+        "CREATE TABLE tasks (id INTEGER PRIMARY KEY AUTOINCREMENT, header TEXT NOT NULL, description TEXT,"
+        "completed INTEGER DEFAULT 0, difficulty INTEGER CHECK(difficulty BETWEEN 1 AND 5), dueDate TEXT);"
+        "INSERT INTO tasks (header, description, completed, difficulty, dueDate) VALUES ('Legacy', '', 0, 2, '2024-02-01');",
+        nullptr, nullptr, nullptr));
+    sqlite3_close(raw);
+    
+    {
+        ToDoList legacyList;
+        legacyList.connect(legacyPath);
+        auto tasks = legacyList.getTasks();
+        ASSERT_EQ(1, tasks.size());
+        EXPECT_EQ("Legacy", tasks[0].header);
+        EXPECT_EQ(1, legacyList.searchTasks("legacy").size());  // Backfilled search index
+    }
+    
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(legacyPath.c_str(), &raw));
+    sqlite3_stmt* stmt = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(raw, "PRAGMA user_version", -1, &stmt, nullptr));
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+    EXPECT_GE(sqlite3_column_int(stmt, 0), 2);
+    sqlite3_finalize(stmt);
+    
+    ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(raw,
+        "SELECT COUNT(*) FROM sqlite_master WHERE type = 'index' AND name = 'idx_tasks_completed'",
+        -1, &stmt, nullptr));
+    ASSERT_EQ(SQLITE_ROW, sqlite3_step(stmt));
+    EXPECT_EQ(1, sqlite3_column_int(stmt, 0));
+    sqlite3_finalize(stmt);
+    sqlite3_close(raw);
+    
+    std::filesystem::remove(legacyPath);
+    std::filesystem::remove(legacyPath + "-wal");
+    std::filesystem::remove(legacyPath + "-shm");
+}
+
+TEST_F(ToDoListTest, ConcurrentReadersSeeCommittedWrites) {
+    todoList.addTask("Seed", "", 1, "");
+    
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([this, &failed] {
+            for (int i = 0; i < 50; ++i) {
+                try {
+                    if (todoList.getTasks().empty()) {
+                        failed = true;
+                    }
+                } catch (const std::exception&) {
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 20; ++i) {
+        todoList.addTask("Task " + std::to_string(i), "", 2, "");
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    
+    EXPECT_FALSE(failed);
+    EXPECT_EQ(21, todoList.getTasks().size());
+}
+
+TEST_F(ToDoListTest, AddTasksInsertsBatchAndReturnsIds) {
+    std::vector<Task> batch = {
+        {0, "Import A", "first", false, 1, "2024-03-01"},
+        {0, "Import B", "second", false, 5, ""},
+    };
+    auto ids = todoList.addTasks(batch);
+    
+    ASSERT_EQ(2, ids.size());
+    EXPECT_LT(ids[0], ids[1]);
+    auto stored = todoList.getTaskById(ids[1]);
+    ASSERT_TRUE(stored.has_value());
+    EXPECT_EQ("Import B", stored->header);
+    EXPECT_EQ(5, stored->difficulty);
+}
+
+TEST_F(ToDoListTest, AddTasksRollsBackWholeBatchOnFailure) {
+    std::vector<Task> batch = {
+        {0, "Valid", "", false, 2, ""},
+        {0, "Invalid difficulty", "", false, 9, ""},
+    };
+    EXPECT_THROW(todoList.addTasks(batch), std::runtime_error);
+    EXPECT_TRUE(todoList.getTasks().empty());
+    
+    // The writer is still usable after the rollback
+    EXPECT_GT(todoList.addTask("After", "", 3, ""), 0);
+}
+
+TEST_F(ToDoListTest, GroupCommitAcknowledgesEachWriter) {
+    todoList.setGroupCommit({true, std::chrono::milliseconds(5), 64});
+    
+    const int writers = 8;
+    const int perWriter = 10;
+    std::vector<std::vector<int>> ids(writers);
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < writers; ++t) {
+        threads.emplace_back([this, t, &ids, &failures] {
+            for (int i = 0; i < perWriter; ++i) {
+                ids[t].push_back(todoList.addTask("Writer " + std::to_string(t), "", 1 + i % 5, ""));
+                // Invalid difficulty: only this write fails, its batch still commits
+                try {
+                    todoList.addTask("Broken", "", 9, "");
+                } catch (const std::runtime_error&) {
+                    ++failures;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    EXPECT_EQ(writers * perWriter, failures);
+    auto tasks = todoList.getTasks();
+    ASSERT_EQ(writers * perWriter, tasks.size());
+    for (int t = 0; t < writers; ++t) {
+        for (int id : ids[t]) {
+            auto task = todoList.getTaskById(id);
+            ASSERT_TRUE(task.has_value());
+            EXPECT_EQ("Writer " + std::to_string(t), task->header);
+        }
+    }
+    
+    // Per-caller change counts and index maintenance still hold
+    int id = ids[0][0];
+    EXPECT_TRUE(todoList.markTaskAsCompleted(id));
+    EXPECT_FALSE(todoList.markTaskAsCompleted(-1));
+    EXPECT_TRUE(todoList.unmarkTaskAsCompleted(id));
+    todoList.editTask(id, "Renamed", "", 3, "");
+    EXPECT_EQ("Renamed", todoList.getTaskById(id)->header);
+    todoList.deleteTask(id);
+    EXPECT_FALSE(todoList.getTaskById(id).has_value());
+    EXPECT_EQ(writers * perWriter - 1, todoList.getPrioritizedTasks(TaskPrioritizer::Strategy::BALANCED).size());
+    
+    // A failing batch insert is still all-or-nothing inside a group
+    std::vector<Task> batch = {
+        {0, "Valid", "", false, 2, ""},
+        {0, "Invalid difficulty", "", false, 9, ""},
+    };
+    EXPECT_THROW(todoList.addTasks(batch), std::runtime_error);
+    EXPECT_EQ(writers * perWriter - 1, todoList.getTasks().size());
+    
+    todoList.setGroupCommit({});
+    EXPECT_GT(todoList.addTask("Direct", "", 2, ""), 0);
+}
+
+TEST(GroupCommitOptionsTest, ReadsWindowFromEnvironment) {
+    unsetenv("TODO_GROUP_COMMIT_US");
+    EXPECT_FALSE(GroupCommitOptions::fromEnvironment().enabled);
+    
+    setenv("TODO_GROUP_COMMIT_US", "1500", 1);
+    auto options = GroupCommitOptions::fromEnvironment();
+    EXPECT_TRUE(options.enabled);
+    EXPECT_EQ(std::chrono::microseconds(1500), options.window);
+    
+    setenv("TODO_GROUP_COMMIT_US", "0", 1);
+    EXPECT_FALSE(GroupCommitOptions::fromEnvironment().enabled);
+    setenv("TODO_GROUP_COMMIT_US", "soon", 1);
+    EXPECT_FALSE(GroupCommitOptions::fromEnvironment().enabled);
+    unsetenv("TODO_GROUP_COMMIT_US");
+}
+
+TEST_F(ToDoListTest, GroupCommitReportsIndexUpdateFailures) {
+    int id = todoList.addTask("Refreshed", "", 2, "");
+    todoList.markTaskAsCompleted(id);
+    todoList.setGroupCommit({true, std::chrono::milliseconds(1), 64});
+    dropDueDayColumn(dbPath);
+    
+    // The unmark commits, but its index refresh fails: the caller gets the error
+    // and the committer keeps serving writes
+    EXPECT_THROW(todoList.unmarkTaskAsCompleted(id), std::runtime_error);
+    EXPECT_TRUE(todoList.markTaskAsCompleted(id));
+    todoList.setGroupCommit({});
+}
+
+TEST_F(ToDoListTest, DataVersionAdvancesOnEveryMutation) {
+    auto version = todoList.getDataVersion();
+    std::string tag = todoList.getDataVersionTag();
+    int id = todoList.addTask("Versioned", "", 2, "");
+    EXPECT_GT(todoList.getDataVersion(), version);
+    EXPECT_NE(tag, todoList.getDataVersionTag());
+    
+    // Reads and failed writes leave it alone
+    version = todoList.getDataVersion();
+    todoList.getTasks();
+    todoList.getPrioritizedTasks();
+    EXPECT_THROW(todoList.addTask("Broken", "", 9, ""), std::runtime_error);
+    EXPECT_EQ(version, todoList.getDataVersion());
+    
+    todoList.markTaskAsCompleted(id);
+    EXPECT_GT(todoList.getDataVersion(), version);
+    version = todoList.getDataVersion();
+    todoList.deleteTask(id);
+    EXPECT_GT(todoList.getDataVersion(), version);
+    
+    // Another instance over the same file starts a different tag sequence
+    ToDoList other;
+    other.connect(dbPath);
+    EXPECT_NE(todoList.getDataVersionTag().substr(0, 16), other.getDataVersionTag().substr(0, 16));
+}
+
+TEST_F(ToDoListTest, DataVersionAdvancesWhenIndexUpdateFails) {
+    int id = todoList.addTask("Refreshed", "", 2, "");
+    todoList.markTaskAsCompleted(id);
+    dropDueDayColumn(dbPath);
+    
+    // The unmark is committed even though refreshing the index fails, so the tag must move
+    auto version = todoList.getDataVersion();
+    EXPECT_THROW(todoList.unmarkTaskAsCompleted(id), std::runtime_error);
+    EXPECT_GT(todoList.getDataVersion(), version);
+}
+
+TEST_F(ToDoListTest, GetTasksPageWalksCursorAndFilters) {
+    for (int i = 1; i <= 5; ++i) {
+        todoList.addTask("Task " + std::to_string(i), "", (i % 2) + 1, i <= 3 ? "2024-01-0" + std::to_string(i) : "");
+    }
+    
+    TaskQuery query;
+    query.limit = 2;
+    auto first = todoList.getTasksPage(query);
+    ASSERT_EQ(2, first.tasks.size());
+    ASSERT_TRUE(first.nextCursor.has_value());
+    
+    query.afterId = *first.nextCursor;
+    auto second = todoList.getTasksPage(query);
+    ASSERT_EQ(2, second.tasks.size());
+    EXPECT_GT(second.tasks[0].id, first.tasks[1].id);
+    
+    query.afterId = *second.nextCursor;
+    auto last = todoList.getTasksPage(query);
+    EXPECT_EQ(1, last.tasks.size());
+    EXPECT_FALSE(last.nextCursor.has_value());
+    
+    TaskQuery filtered;
+    filtered.dueTo = "2024-01-02";
+    auto dueEarly = todoList.getTasksPage(filtered);
+    ASSERT_EQ(2, dueEarly.tasks.size());
+    EXPECT_EQ("Task 1", dueEarly.tasks[0].header);
+    
+    filtered = TaskQuery();
+    filtered.difficulty = 2;
+    EXPECT_EQ(3, todoList.getTasksPage(filtered).tasks.size());
+}
+
+TEST_F(ToDoListTest, ForEachTaskStreamsRowViews) {
+    todoList.addTask("Open", "visible", 2, "2024-05-01");
+    int doneId = todoList.addTask("Done", "", 3, "");
+    todoList.markTaskAsCompleted(doneId);
+    
+    std::vector<std::string> headers;
+    todoList.forEachTask([&headers](const TaskView& task) {
+        headers.emplace_back(task.header);
+        EXPECT_EQ("visible", task.description);
+        EXPECT_EQ("2024-05-01", task.dueDate);
+    });
+    ASSERT_EQ(1, headers.size());
+    EXPECT_EQ("Open", headers[0]);
+    
+    int completedCount = 0;
+    todoList.forEachCompletedTask([&completedCount](const TaskView& task) {
+        EXPECT_TRUE(task.completed);
+        ++completedCount;
+    });
+    EXPECT_EQ(1, completedCount);
+}
+
+TEST_F(ToDoListTest, ScansFailLoudlyAndResetOnEveryExit) {
+    todoList.addTask("First", "", 2, "");
+    todoList.addTask("Second", "", 2, "");
+    
+    // A visitor that throws leaves the statement reset, so the next scan starts over
+    EXPECT_THROW(todoList.forEachTask([](const TaskView&) { throw std::runtime_error("stop"); }),
+                 std::runtime_error);
+    int count = 0;
+    todoList.forEachTask([&count](const TaskView&) { ++count; });
+    EXPECT_EQ(2, count);
+    
+    // A failing step is an error, not a shorter list
+    dropDueDayColumn(dbPath);
+    EXPECT_THROW(todoList.getTasks(), std::runtime_error);
+    EXPECT_THROW(todoList.getCompletedTasks(), std::runtime_error);
+    EXPECT_THROW(todoList.forEachTask([](const TaskView&) {}), std::runtime_error);
+}
+
+TEST_F(ToDoListTest, StoresDueDateAsEpochDay) {
+    int id = todoList.addTask("Dated", "", 2, "1970-01-11");
+    int undatedId = todoList.addTask("Undated", "", 2, "");
+    
+    EXPECT_EQ(10, todoList.getTaskById(id)->dueDay);
+    EXPECT_EQ(NO_DUE_DAY, todoList.getTaskById(undatedId)->dueDay);
+    
+    todoList.editTask(id, "Dated", "", 2, "1970-01-02");
+    EXPECT_EQ(1, todoList.getTaskById(id)->dueDay);
+    
+    TaskQuery query;
+    query.dueFrom = "1970-01-01";
+    auto page = todoList.getTasksPage(query);
+    ASSERT_EQ(1, page.tasks.size());
+    EXPECT_EQ(id, page.tasks[0].id);
+}
+
+TEST_F(ToDoListTest, PrioritizedTasksTrackMutations) {
+    int a = todoList.addTask("A", "", 1, "2030-01-10");
+    int b = todoList.addTask("B", "", 5, "2030-01-10");
+    
+    // First read loads the index
+    auto initial = todoList.getPrioritizedTasks(TaskPrioritizer::Strategy::DUE_DATE_FIRST);
+    ASSERT_EQ(2, initial.size());
+    EXPECT_EQ(b, initial[0].id);
+    
+    int c = todoList.addTask("C", "", 1, "2030-01-01");
+    todoList.editTask(a, "A", "", 1, "2029-12-01");
+    todoList.markTaskAsCompleted(b);
+    
+    auto updated = todoList.getPrioritizedTasks(TaskPrioritizer::Strategy::DUE_DATE_FIRST);
+    ASSERT_EQ(2, updated.size());
+    EXPECT_EQ(a, updated[0].id);
+    EXPECT_EQ("2029-12-01", updated[0].dueDate);
+    EXPECT_EQ(c, updated[1].id);
+    
+    todoList.unmarkTaskAsCompleted(b);
+    todoList.deleteTask(a);
+    auto top = todoList.getPrioritizedTasks(TaskPrioritizer::Strategy::DUE_DATE_FIRST, 1);
+    ASSERT_EQ(1, top.size());
+    EXPECT_EQ(c, top[0].id);
+    
+    // The index agrees with prioritizing a fresh read for every strategy
+    for (auto strategy : TaskPrioritizer::allStrategies()) {
+        auto expected = todoList.getTasks();
+        TaskPrioritizer(strategy).prioritizeTasks(expected);
+        auto actual = todoList.getPrioritizedTasks(strategy);
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_EQ(expected[i].id, actual[i].id);
+        }
+    }
+}
+
+TEST_F(ToDoListTest, PrioritizedTasksUseCustomWeights) {
+    int soon = todoList.addTask("Soon", "", 1, "2000-01-01");
+    int hard = todoList.addTask("Hard", "", 5, "2100-01-01");
+    
+    // Only the due date counts, then only the difficulty
+    auto byDate = todoList.getPrioritizedTasks(TaskPrioritizer({1.0, 0.0}));
+    ASSERT_EQ(2, byDate.size());
+    EXPECT_EQ(soon, byDate[0].id);
+    
+    auto byDifficulty = todoList.getPrioritizedTasks(TaskPrioritizer({0.0, 1.0}), 1);
+    ASSERT_EQ(1, byDifficulty.size());
+    EXPECT_EQ(hard, byDifficulty[0].id);
+}
+
+TEST_F(ToDoListTest, SearchRanksMatchesAndFollowsEdits) {
+    int groceries = todoList.addTask("Buy groceries", "milk, eggs and bread", 1, "");
+    int bakery = todoList.addTask("Call the bakery", "order bread for the party", 2, "");
+    int report = todoList.addTask("Write report", "quarterly numbers", 3, "");
+    todoList.markTaskAsCompleted(report);
+    
+    // Header matches outrank description matches; completed tasks are included
+    auto bread = todoList.searchTasks("bread");
+    ASSERT_EQ(2, bread.size());
+    EXPECT_EQ(groceries, bread[0].id);
+    EXPECT_EQ(bakery, bread[1].id);
+    EXPECT_EQ(1, todoList.searchTasks("bakery bread").size());
+    EXPECT_EQ(1, todoList.searchTasks("Groc").size());  // Last word matches as a prefix
+    EXPECT_EQ(report, todoList.searchTasks("quarterly").at(0).id);
+    EXPECT_EQ(1, todoList.searchTasks("bread", 1).size());
+    
+    todoList.editTask(groceries, "Buy vegetables", "carrots", 1, "");
+    todoList.deleteTask(bakery);
+    EXPECT_TRUE(todoList.searchTasks("bread").empty());
+    EXPECT_EQ(groceries, todoList.searchTasks("carrots").at(0).id);
+}
+
+TEST_F(ToDoListTest, SearchTreatsQuerySyntaxAsText) {
+    todoList.addTask("Fix \"NOT\" operator", "handles AND/OR (and NEAR)", 2, "");
+    
+    EXPECT_EQ(1, todoList.searchTasks("NOT").size());
+    EXPECT_EQ(1, todoList.searchTasks("\"not").size());
+    EXPECT_EQ(1, todoList.searchTasks("near( AND").size());
+    EXPECT_TRUE(todoList.searchTasks("   ").empty());
+    EXPECT_TRUE(todoList.searchTasks("- * :").empty());
+}
+
+TEST_F(ToDoListTest, SuggestHeadersByPrefixAndFrequency) {
+    todoList.addTask("Buy milk", "", 1, "");
+    int eggs = todoList.addTask("Buy eggs", "", 1, "");
+    todoList.addTask("buy milk", "", 1, "");
+    todoList.addTask("Bake bread", "", 1, "");
+    
+    // Case-insensitive prefix, most used first, then alphabetical
+    auto suggestions = todoList.suggestHeaders("BU");
+    ASSERT_EQ(2, suggestions.size());
+    EXPECT_EQ("buy milk", suggestions[0].header);
+    EXPECT_EQ(2, suggestions[0].count);
+    EXPECT_EQ("Buy eggs", suggestions[1].header);
+    EXPECT_EQ(3, todoList.suggestHeaders("b").size());
+    EXPECT_EQ(1, todoList.suggestHeaders("b", 1).size());
+    
+    // Mutations after the index is loaded are reflected
+    todoList.editTask(eggs, "Call mom", "", 1, "");
+    todoList.addTask("Buy apples", "", 1, "");
+    auto updated = todoList.suggestHeaders("buy ");
+    ASSERT_EQ(2, updated.size());
+    EXPECT_EQ("Buy apples", updated[1].header);
+    EXPECT_EQ("Call mom", todoList.suggestHeaders("c").at(0).header);
+    
+    todoList.deleteTask(eggs);
+    EXPECT_TRUE(todoList.suggestHeaders("call").empty());
+}
+
+TEST_F(ToDoListTest, SqlPriorityEngineMatchesInMemoryOrder) {
+    const char* dates[] = {"2030-01-10", "", "2000-05-05", "2030-01-10", "not a date", "2031-07-01"};
+    for (int i = 0; i < 30; ++i) {
+        todoList.addTask("Task " + std::to_string(i), "", i % 5 + 1, dates[i % 6]);
+    }
+    todoList.markTaskAsCompleted(3);
+    
+    std::vector<TaskPrioritizer> prioritizers;
+    for (auto strategy : TaskPrioritizer::allStrategies()) {
+        prioritizers.emplace_back(strategy);
+    }
+    prioritizers.emplace_back(TaskPrioritizer::Weights{0.5, 3.0});
+    
+    for (const auto& prioritizer : prioritizers) {
+        for (size_t limit : {0, 7}) {
+            todoList.setPriorityEngine(ToDoList::PriorityEngine::IN_MEMORY);
+            auto expected = todoList.getPrioritizedTasks(prioritizer, limit);
+            todoList.setPriorityEngine(ToDoList::PriorityEngine::SQL);
+            auto actual = todoList.getPrioritizedTasks(prioritizer, limit);
+            
+            ASSERT_EQ(expected.size(), actual.size());
+            for (size_t i = 0; i < expected.size(); ++i) {
+                EXPECT_EQ(expected[i].id, actual[i].id) << TaskPrioritizer::strategyName(prioritizer.getStrategy()) << " at " << i;
+            }
+        }
+    }
+}
+
+TEST_F(ToDoListTest, SqlPriorityOrderUsesIndexes) {
+    sqlite3* raw = nullptr;
+    ASSERT_EQ(SQLITE_OK, sqlite3_open(dbPath.c_str(), &raw));
+    for (const char* orderBy : {"dueDay, difficulty DESC, id", "difficulty, dueDay, id"}) {
+        std::string sql = std::string("EXPLAIN QUERY PLAN SELECT id FROM tasks WHERE completed = 0 ORDER BY ") + orderBy + " LIMIT 10";
+        sqlite3_stmt* stmt = nullptr;
+        ASSERT_EQ(SQLITE_OK, sqlite3_prepare_v2(raw, sql.c_str(), -1, &stmt, nullptr));
+        std::string plan;
+        while (sqlite3_step(stmt) == SQLITE_ROW) {
+            plan += reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3));
+            plan += "\n";
+        }
+        sqlite3_finalize(stmt);
+        EXPECT_EQ(std::string::npos, plan.find("TEMP B-TREE")) << orderBy << ":\n" << plan;
+    }
+    sqlite3_close(raw);
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <curl/curl.h>
+#include "JsonReader.h"
+#include <chrono>
+#include <map>
 #include <string>
 #include <iostream>
 
@@ -14,6 +17,77 @@ static size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::stri
     }
 }
 
+// Callback function to collect response headers from Curl
+static size_t HeaderCallback(char* buffer, size_t size, size_t nitems, std::string* s) {
+    s->append(buffer, size * nitems);
+    return size * nitems;
+}
+
+// A JSON body flattened to its scalar values keyed by path, e.g. "tasks.0.header" or
+// "strategies.3.weights.dueWeight"; strings as is, numbers and booleans as text
+using JsonFields = std::map<std::string, std::string>;
+
+static void flattenJson(JsonReader& json, const std::string& path, JsonFields& fields) {
+    std::string prefix = path.empty() ? "" : path + ".";
+    switch (json.peek()) {
+    case JsonReader::Type::OBJECT: {
+        json.beginObject();
+        std::string_view key;
+        while (json.nextMember(key)) {
+            flattenJson(json, prefix + std::string(key), fields);
+        }
+        break;
+    }
+    case JsonReader::Type::ARRAY: {
+        json.beginArray();
+        for (int i = 0; json.nextElement(); ++i) {
+            flattenJson(json, prefix + std::to_string(i), fields);
+        }
+        break;
+    }
+    case JsonReader::Type::STRING:
+        fields[path] = std::string(json.string());
+        break;
+    case JsonReader::Type::NUMBER:
+        fields[path] = std::to_string(json.integer());
+        break;
+    case JsonReader::Type::BOOLEAN:
+        fields[path] = json.boolean() ? "true" : "false";
+        break;
+    case JsonReader::Type::NULL_VALUE:
+        json.null();
+        fields[path] = "null";
+        break;
+    }
+}
+
+static JsonFields parseJson(const std::string& body) {
+    JsonFields fields;
+    JsonReader json(body);
+    flattenJson(json, "", fields);
+    json.end();
+    return fields;
+}
+
+// Number of elements of array `name` whose `field` is set
+static int countElements(const JsonFields& fields, const std::string& name, const std::string& field) {
+    int count = 0;
+    while (fields.count(name + "." + std::to_string(count) + "." + field)) {
+        ++count;
+    }
+    return count;
+}
+
+// Letters-only word unique to this test run, so earlier runs' tasks do not interfere
+static std::string uniqueWord(const std::string& stem) {
+    std::string word = stem;
+    auto now = std::chrono::system_clock::now().time_since_epoch().count();
+    for (auto t = now; t > 0; t /= 26) {
+        word += static_cast<char>('a' + t % 26);
+    }
+    return word;
+}
+
 class ApiTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -44,6 +118,87 @@ protected:
         
         return readBuffer;
     }
+    
+    // GET returning the status code, with the body in `body`
+    long performGetStatus(const std::string& url, std::string& body) {
+        CURL* curl = curl_easy_init();
+        long status = 0;
+        body.clear();
+        
+        if(curl) {
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &body);
+            
+            if (curl_easy_perform(curl) == CURLE_OK) {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+            }
+            
+            curl_easy_cleanup(curl);
+        }
+        
+        return status;
+    }
+    
+    // POST a JSON body, returning the status code
+    long performPost(const std::string& url, const std::string& body) {
+        CURL* curl = curl_easy_init();
+        std::string readBuffer;
+        long status = 0;
+        
+        if(curl) {
+            struct curl_slist* requestHeaders = curl_slist_append(nullptr, "Content-Type: application/json");
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, requestHeaders);
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, body.c_str());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
+            
+            if (curl_easy_perform(curl) == CURLE_OK) {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+            }
+            
+            curl_slist_free_all(requestHeaders);
+            curl_easy_cleanup(curl);
+        }
+        
+        return status;
+    }
+    
+    // GET with an optional If-None-Match header; returns the status code and the ETag sent back
+    long performConditionalGet(const std::string& url, const std::string& ifNoneMatch, std::string& etag) {
+        CURL* curl = curl_easy_init();
+        std::string readBuffer;
+        std::string headers;
+        long status = 0;
+        
+        if(curl) {
+            struct curl_slist* requestHeaders = nullptr;
+            if (!ifNoneMatch.empty()) {
+                requestHeaders = curl_slist_append(requestHeaders, ("If-None-Match: " + ifNoneMatch).c_str());
+            }
+            curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, requestHeaders);
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
+            curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+            curl_easy_setopt(curl, CURLOPT_HEADERDATA, &headers);
+            
+            if (curl_easy_perform(curl) == CURLE_OK) {
+                curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+            }
+            
+            curl_slist_free_all(requestHeaders);
+            curl_easy_cleanup(curl);
+        }
+        
+        etag.clear();
+        size_t pos = headers.find("ETag: ");
+        if (pos != std::string::npos) {
+            etag = headers.substr(pos + 6, headers.find("\r\n", pos) - pos - 6);
+        }
+        return status;
+    }
 };
 
 // Test the health endpoint
@@ -60,6 +215,121 @@ TEST_F(ApiTest, GetAllTasks) {
     // Further assertions would depend on expected response format
 }
 
+// Malformed due date filters are rejected instead of matching nothing
+TEST_F(ApiTest, RejectsMalformedDueDateFilters) {
+    std::string body;
+    EXPECT_EQ(200, performGetStatus("http://localhost:8080/api/tasks?due_from=2024-01-01", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks?due_from=2024-ab-cd", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks?due_to=2024-13-01", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/completed?due_from=tomorrow", body));
+}
+
+// Test listing the prioritization strategies and selecting one
+TEST_F(ApiTest, PrioritizationStrategies) {
+    std::string body;
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/prioritization/strategies", body));
+    JsonFields strategies = parseJson(body);
+    ASSERT_EQ(4, countElements(strategies, "strategies", "key"));
+    EXPECT_EQ("due_date_first", strategies["strategies.0.key"]);
+    EXPECT_EQ("difficulty_first", strategies["strategies.1.key"]);
+    EXPECT_EQ("balanced", strategies["strategies.2.key"]);
+    EXPECT_EQ("weighted", strategies["strategies.3.key"]);
+    EXPECT_EQ("3", strategies["strategies.3.id"]);
+    EXPECT_EQ("1", strategies["strategies.3.weights.dueWeight"]);
+    EXPECT_EQ("1", strategies["strategies.3.weights.difficultyWeight"]);
+    EXPECT_EQ(0, strategies.count("strategies.2.weights.dueWeight"));
+    EXPECT_EQ("balanced", strategies["default"]);
+    
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/prioritized?strategy=weighted&dueWeight=2", body));
+    EXPECT_NO_THROW(parseJson(body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/prioritized?strategy=unknown", body));
+}
+
+// Test full-text search: best match first, limit capped at 100
+TEST_F(ApiTest, SearchTasks) {
+    std::string word = uniqueWord("search");
+    ASSERT_EQ(201, performPost("http://localhost:8080/api/tasks",
+        R"({"header":"Unrelated title","description":"mentions )" + word + R"( among several other words","difficulty":2})"));
+    ASSERT_EQ(201, performPost("http://localhost:8080/api/tasks", R"({"header":")" + word + R"(","difficulty":2})"));
+    
+    std::string body;
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/search?q=" + word, body));
+    JsonFields found = parseJson(body);
+    ASSERT_EQ(2, countElements(found, "tasks", "id"));
+    EXPECT_EQ(word, found["tasks.0.header"]);  // Header match outranks the description match
+    EXPECT_EQ("Unrelated title", found["tasks.1.header"]);
+    
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/search?q=" + word + "&limit=1", body));
+    found = parseJson(body);
+    ASSERT_EQ(1, countElements(found, "tasks", "id"));
+    EXPECT_EQ(word, found["tasks.0.header"]);
+    
+    EXPECT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/search?q=" + word + "&limit=100", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/search?q=" + word + "&limit=101", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/search?q=" + word + "&limit=0", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/search", body));
+}
+
+// Test header suggestions: most used first, limit capped at 50
+TEST_F(ApiTest, SuggestHeaders) {
+    std::string prefix = uniqueWord("suggest");
+    for (const char* suffix : {" alpha", " beta", " gamma", " alpha", " gamma", " alpha"}) {
+        ASSERT_EQ(201, performPost("http://localhost:8080/api/tasks",
+                                   R"({"header":")" + prefix + suffix + R"(","difficulty":1})"));
+    }
+    
+    std::string body;
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/suggest?prefix=" + prefix, body));
+    JsonFields suggested = parseJson(body);
+    ASSERT_EQ(3, countElements(suggested, "suggestions", "header"));
+    EXPECT_EQ(prefix + " alpha", suggested["suggestions.0.header"]);
+    EXPECT_EQ("3", suggested["suggestions.0.count"]);
+    EXPECT_EQ(prefix + " gamma", suggested["suggestions.1.header"]);
+    EXPECT_EQ("2", suggested["suggestions.1.count"]);
+    EXPECT_EQ(prefix + " beta", suggested["suggestions.2.header"]);
+    EXPECT_EQ("1", suggested["suggestions.2.count"]);
+    
+    ASSERT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/suggest?prefix=" + prefix + "&limit=2", body));
+    suggested = parseJson(body);
+    ASSERT_EQ(2, countElements(suggested, "suggestions", "header"));
+    EXPECT_EQ(prefix + " alpha", suggested["suggestions.0.header"]);
+    
+    EXPECT_EQ(200, performGetStatus("http://localhost:8080/api/tasks/suggest?prefix=" + prefix + "&limit=50", body));
+    EXPECT_EQ(400, performGetStatus("http://localhost:8080/api/tasks/suggest?prefix=" + prefix + "&limit=51", body));
+}
+
+// Unchanged task data answers a matching If-None-Match with 304 and no body
+TEST_F(ApiTest, ConditionalGetReturnsNotModified) {
+    std::string etag;
+    ASSERT_EQ(200, performConditionalGet("http://localhost:8080/api/tasks", "", etag));
+    ASSERT_FALSE(etag.empty());
+    
+    std::string again;
+    EXPECT_EQ(304, performConditionalGet("http://localhost:8080/api/tasks", etag, again));
+    EXPECT_EQ(etag, again);
+    EXPECT_EQ(200, performConditionalGet("http://localhost:8080/api/tasks", "\"stale\"", again));
+}
+
+// Requests on one curl handle reuse the server's keep-alive connection
+TEST_F(ApiTest, KeepAliveReusesConnection) {
+    CURL* curl = curl_easy_init();
+    ASSERT_NE(nullptr, curl);
+    std::string readBuffer;
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
+    
+    long connects = 0;
+    for (const char* url : {"http://localhost:8080/health", "http://localhost:8080/api/tasks", "http://localhost:8080/health"}) {
+        curl_easy_setopt(curl, CURLOPT_URL, url);
+        ASSERT_EQ(CURLE_OK, curl_easy_perform(curl));
+        long newConnections = 0;
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+        connects += newConnections;
+    }
+    curl_easy_cleanup(curl);
+    EXPECT_EQ(1, connects);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
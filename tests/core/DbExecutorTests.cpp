@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "DbExecutor.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+
+using Lane = DbExecutor::Lane;
+
+TEST(DbExecutorTest, RunsJobsOnBothLanes) {
+    DbExecutor executor(2, 1);
+    std::atomic<int> done{0};
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(executor.submit(i % 2 ? Lane::READ : Lane::WRITE, [&done] { ++done; }));
+    }
+    executor.shutdown();  // Drains before returning
+    EXPECT_EQ(10, done);
+}
+
+TEST(DbExecutorTest, RejectsWhenLaneQueueIsFull) {
+    DbExecutor executor(1, 1, 2);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::promise<void> started;
+    
+    // Occupy the only write worker, then fill its queue
+    ASSERT_TRUE(executor.submit(Lane::WRITE, [&started, released] {
+        started.set_value();
+        released.wait();
+    }));
+    started.get_future().wait();
+    std::atomic<int> done{0};
+    EXPECT_TRUE(executor.submit(Lane::WRITE, [&done] { ++done; }));
+    EXPECT_TRUE(executor.submit(Lane::WRITE, [&done] { ++done; }));
+    EXPECT_FALSE(executor.submit(Lane::WRITE, [&done] { ++done; }));
+    
+    // The read lane has its own queue
+    EXPECT_TRUE(executor.submit(Lane::READ, [&done] { ++done; }));
+    
+    release.set_value();
+    executor.shutdown();
+    EXPECT_EQ(3, done);
+    EXPECT_FALSE(executor.submit(Lane::READ, [] {}));
+}
+
+TEST(DbExecutorTest, ReadsDoNotWaitForStalledWrite) {
+    DbExecutor executor(1, 1);
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    ASSERT_TRUE(executor.submit(Lane::WRITE, [released] { released.wait(); }));
+    
+    std::promise<void> read;
+    EXPECT_TRUE(executor.submit(Lane::READ, [&read] { read.set_value(); }));
+    auto status = read.get_future().wait_for(std::chrono::seconds(5));
+    release.set_value();
+    EXPECT_EQ(std::future_status::ready, status);
+}
+
+TEST(DbExecutorTest, WorkerSurvivesThrowingJob) {
+    DbExecutor executor(1, 1);
+    ASSERT_TRUE(executor.submit(Lane::READ, [] { throw std::runtime_error("boom"); }));
+    std::promise<void> next;
+    ASSERT_TRUE(executor.submit(Lane::READ, [&next] { next.set_value(); }));
+    EXPECT_EQ(std::future_status::ready, next.get_future().wait_for(std::chrono::seconds(5)));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,29 @@
+#include <gtest/gtest.h>
+#include "ETag.h"
+#include "ToDoList.h"
+
+TEST(ETagTest, FollowsTheDataVersion) {
+    ToDoList todoList;
+    todoList.connect(":memory:");
+    std::string etag = dataETag(todoList);
+    EXPECT_EQ("\"" + todoList.getDataVersionTag() + "\"", etag);
+    EXPECT_EQ("\"" + todoList.getDataVersionTag() + "-20000\"", dataETag(todoList, "20000"));
+    
+    todoList.addTask("Tagged", "", 2, "");
+    EXPECT_NE(etag, dataETag(todoList));
+}
+
+TEST(ETagTest, MatchesIfNoneMatchLists) {
+    const std::string etag = "\"abc-1\"";
+    EXPECT_TRUE(etagMatches("\"abc-1\"", etag));
+    EXPECT_TRUE(etagMatches("W/\"abc-1\"", etag));
+    EXPECT_TRUE(etagMatches("*", etag));
+    EXPECT_TRUE(etagMatches("\"old\", \t\"abc-1\" ", etag));
+    EXPECT_TRUE(etagMatches("\"old\",W/\"abc-1\"", etag));
+    
+    EXPECT_FALSE(etagMatches("", etag));
+    EXPECT_FALSE(etagMatches("\"abc-2\"", etag));
+    EXPECT_FALSE(etagMatches("abc-1", etag));
+    EXPECT_FALSE(etagMatches("\"abc-1\"x", etag));
+    EXPECT_FALSE(etagMatches(" , ,", etag));
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "HeaderSuggester.h"
+#include <random>
+
+static std::vector<std::string> headersOf(const std::vector<HeaderSuggester::Suggestion>& suggestions) {
+    std::vector<std::string> headers;
+    for (const auto& suggestion : suggestions) {
+        headers.push_back(suggestion.header);
+    }
+    return headers;
+}
+
+TEST(HeaderSuggesterTest, NormalizesCaseAndSurroundingSpace) {
+    EXPECT_EQ("buy milk", HeaderSuggester::normalize("  Buy MILK\t"));
+    
+    HeaderSuggester suggester;
+    suggester.load({{1, "Buy milk"}, {2, " buy milk "}, {3, "   "}});
+    auto suggestions = suggester.suggest("BUY", 10);
+    ASSERT_EQ(1, suggestions.size());
+    EXPECT_EQ(2, suggestions[0].count);
+}
+
+TEST(HeaderSuggesterTest, IgnoresUpdatesUntilLoaded) {
+    HeaderSuggester suggester;
+    suggester.upsert(1, "Buy milk");
+    suggester.load({});
+    EXPECT_TRUE(suggester.suggest("", 10).empty());
+}
+
+TEST(HeaderSuggesterTest, CachedResultsFollowMutations) {
+    // Few distinct headers so cached lists are both full (maxLimit) and partial
+    std::mt19937 rng(7);
+    auto randomHeader = [&rng] {
+        return std::string(1, static_cast<char>('a' + rng() % 3)) + std::to_string(rng() % 40);
+    };
+    
+    std::vector<std::pair<int, std::string>> tasks;
+    for (int id = 0; id < 300; ++id) {
+        tasks.emplace_back(id, randomHeader());
+    }
+    HeaderSuggester suggester;
+    suggester.load(tasks);
+    
+    const char* prefixes[] = {"", "a", "b1", "c2", "a3"};
+    for (int step = 0; step < 2000; ++step) {
+        for (const char* prefix : prefixes) {
+            suggester.suggest(prefix, 5);  // Keep every prefix cached
+        }
+        
+        // Rename, delete (an empty header is never indexed) or restore a task
+        auto& task = tasks[rng() % tasks.size()];
+        switch (rng() % 3) {
+            case 0:
+                task.second = randomHeader();
+                suggester.upsert(task.first, task.second);
+                break;
+            case 1:
+                task.second.clear();
+                suggester.remove(task.first);
+                break;
+            default:
+                if (task.second.empty()) {
+                    task.second = randomHeader();
+                }
+                suggester.upsert(task.first, task.second);
+                break;
+        }
+        
+        HeaderSuggester fresh;
+        fresh.load(tasks);
+        for (const char* prefix : prefixes) {
+            ASSERT_EQ(headersOf(fresh.suggest(prefix, HeaderSuggester::maxLimit)),
+                      headersOf(suggester.suggest(prefix, HeaderSuggester::maxLimit)))
+                << "prefix '" << prefix << "' at step " << step;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
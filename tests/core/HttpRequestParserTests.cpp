@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include "HttpRequestParser.h"
+#include <string>
+
+using Status = HttpRequestParser::Status;
+
+TEST(HttpRequestParserTest, ParsesRequestLineHeadersAndQuery) {
+    std::string input = "GET /api/tasks/search?q=milk&limit=5 HTTP/1.1\r\n"
+                        "Host: localhost\r\n"
+                        "If-None-Match:   \"abc\"  \r\n"
+                        "X-Empty:\r\n"
+                        "\r\n";
+    HttpRequestParser parser;
+    ASSERT_EQ(Status::COMPLETE, parser.parse(input));
+    const HttpRequestView& request = parser.request();
+    EXPECT_EQ("GET", request.method);
+    EXPECT_EQ("/api/tasks/search?q=milk&limit=5", request.target);
+    EXPECT_EQ("/api/tasks/search", request.path);
+    EXPECT_EQ("q=milk&limit=5", request.query);
+    EXPECT_EQ("HTTP/1.1", request.version);
+    ASSERT_EQ(3u, request.headers.size());
+    EXPECT_EQ("localhost", request.header("host"));
+    EXPECT_EQ("\"abc\"", request.header("IF-NONE-MATCH"));
+    EXPECT_EQ("", request.header("X-Empty"));
+    EXPECT_EQ("", request.header("Missing"));
+    EXPECT_TRUE(request.body.empty());
+    EXPECT_EQ(input.size(), parser.consumed());
+    EXPECT_TRUE(request.keepAlive());
+}
+
+TEST(HttpRequestParserTest, ResumesAcrossPartialReads) {
+    std::string full = "POST /api/tasks HTTP/1.1\r\n"
+                       "Content-Length: 11\r\n"
+                       "\r\n"
+                       "hello world"
+                       "GET /health HTTP/1.1\r\n\r\n";
+    HttpRequestParser parser;
+    std::string input;
+    std::size_t fed = 0;
+    // One byte at a time, so every split of the head and the body is exercised
+    Status status = Status::INCOMPLETE;
+    while (status == Status::INCOMPLETE && fed < full.size()) {
+        input += full[fed++];
+        status = parser.parse(input);
+    }
+    ASSERT_EQ(Status::COMPLETE, status);
+    EXPECT_EQ("POST", parser.request().method);
+    EXPECT_EQ("hello world", parser.request().body);
+    EXPECT_EQ(fed, parser.consumed());
+
+    // The pipelined request behind it parses after reset
+    input.erase(0, parser.consumed());
+    input += full.substr(fed);
+    parser.reset();
+    ASSERT_EQ(Status::COMPLETE, parser.parse(input));
+    EXPECT_EQ("/health", parser.request().path);
+    EXPECT_EQ(input.size(), parser.consumed());
+}
+
+TEST(HttpRequestParserTest, DecodesChunkedBodies) {
+    std::string full = "PUT /api/tasks/1 HTTP/1.1\r\n"
+                       "Transfer-Encoding: chunked\r\n"
+                       "\r\n"
+                       "5\r\nhello\r\n"
+                       "1;name=value\r\n \r\n"
+                       "A\r\n0123456789\r\n"
+                       "0\r\n"
+                       "X-Trailer: ignored\r\n"
+                       "\r\n";
+    HttpRequestParser whole;
+    ASSERT_EQ(Status::COMPLETE, whole.parse(full));
+    EXPECT_EQ("hello 0123456789", whole.request().body);
+    EXPECT_EQ(full.size(), whole.consumed());
+
+    HttpRequestParser partial;
+    std::string input;
+    for (char c : full) {
+        input += c;
+        Status status = partial.parse(input);
+        ASSERT_NE(Status::FAILED, status);
+        if (input.size() < full.size()) {
+            ASSERT_EQ(Status::INCOMPLETE, status);
+        }
+    }
+    ASSERT_EQ(Status::COMPLETE, partial.parse(input));
+    EXPECT_EQ("hello 0123456789", partial.request().body);
+}
+
+TEST(HttpRequestParserTest, SkipsEmptyLinesBeforeTheRequest) {
+    HttpRequestParser parser;
+    std::string input = "\r\nGET /health HTTP/1.1\r\n\r\n";
+    ASSERT_EQ(Status::COMPLETE, parser.parse(input));
+    EXPECT_EQ("GET", parser.request().method);
+    EXPECT_EQ(input.size(), parser.consumed());
+}
+
+TEST(HttpRequestParserTest, RejectsMalformedRequests) {
+    struct Case {
+        const char* input;
+        int status;
+    };
+    const Case cases[] = {
+        {"GET\r\n\r\n", 400},
+        {"GET  HTTP/1.1\r\n\r\n", 400},
+        {"GET / HTTP/1.1 extra\r\n\r\n", 400},
+        {"GET / HTTX/1.1\r\n\r\n", 400},
+        {"GET / HTTP/2.0\r\n\r\n", 505},
+        {"GET / HTTP/1.1\r\nNo colon\r\n\r\n", 400},
+        {"GET / HTTP/1.1\r\nName : value\r\n\r\n", 400},
+        {"GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nContent-Length: 12x\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n", 501},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 3\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n", 400},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n2\r\nabcd", 400},
+    };
+    for (const auto& c : cases) {
+        HttpRequestParser parser;
+        EXPECT_EQ(Status::FAILED, parser.parse(c.input)) << c.input;
+        EXPECT_EQ(c.status, parser.errorStatus()) << c.input;
+        EXPECT_FALSE(parser.errorMessage().empty());
+        EXPECT_EQ(Status::FAILED, parser.parse(c.input));  // Stays failed
+    }
+}
+
+TEST(HttpRequestParserTest, EnforcesLimits) {
+    HttpRequestLimits limits;
+    limits.maxHeadSize = 64;
+    limits.maxHeaderCount = 2;
+    limits.maxBodySize = 8;
+
+    HttpRequestParser parser(limits);
+    EXPECT_EQ(Status::FAILED, parser.parse("GET /" + std::string(100, 'a')));
+    EXPECT_EQ(431, parser.errorStatus());
+
+    parser.reset();
+    EXPECT_EQ(Status::FAILED, parser.parse("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\nC: 3\r\n\r\n"));
+    EXPECT_EQ(431, parser.errorStatus());
+
+    parser.reset();
+    EXPECT_EQ(Status::FAILED, parser.parse("POST / HTTP/1.1\r\nContent-Length: 9\r\n\r\n"));
+    EXPECT_EQ(413, parser.errorStatus());
+
+    parser.reset();
+    EXPECT_EQ(Status::FAILED, parser.parse("POST / HTTP/1.1\r\nContent-Length: 99999999999999999999999\r\n\r\n"));
+    EXPECT_EQ(413, parser.errorStatus());
+
+    // Chunked bodies are limited by their decoded size, checked chunk by chunk
+    parser.reset();
+    EXPECT_EQ(Status::INCOMPLETE, parser.parse("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nabcde\r\n"));
+    EXPECT_EQ(Status::FAILED, parser.parse("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nabcde\r\n4\r\n"));
+    EXPECT_EQ(413, parser.errorStatus());
+
+    parser.reset();
+    ASSERT_EQ(Status::COMPLETE, parser.parse("POST / HTTP/1.1\r\nContent-Length: 8\r\n\r\n12345678"));
+    EXPECT_EQ("12345678", parser.request().body);
+}
+
+TEST(HttpRequestParserTest, ConnectionPersistence) {
+    auto keepAlive = [](const std::string& input) {
+        HttpRequestParser parser;
+        EXPECT_EQ(Status::COMPLETE, parser.parse(input));
+        return parser.request().keepAlive();
+    };
+    EXPECT_TRUE(keepAlive("GET / HTTP/1.1\r\n\r\n"));
+    EXPECT_TRUE(keepAlive("GET / HTTP/1.1\r\nConnection: keep-alive\r\n\r\n"));
+    EXPECT_FALSE(keepAlive("GET / HTTP/1.1\r\nConnection: Close\r\n\r\n"));
+    EXPECT_FALSE(keepAlive("GET / HTTP/1.1\r\nconnection: upgrade, close\r\n\r\n"));
+    EXPECT_FALSE(keepAlive("GET / HTTP/1.0\r\n\r\n"));
+}
+
+TEST(HttpRequestParserTest, QueryParameters) {
+    std::string_view query = "q=buy+milk%21&empty=&flag&limit=5";
+    bool found = false;
+    EXPECT_EQ("buy+milk%21", HttpRequestParser::queryParam(query, "q", &found));
+    EXPECT_TRUE(found);
+    EXPECT_EQ("buy milk!", HttpRequestParser::urlDecode(HttpRequestParser::queryParam(query, "q")));
+    EXPECT_EQ("", HttpRequestParser::queryParam(query, "empty", &found));
+    EXPECT_TRUE(found);
+    EXPECT_EQ("", HttpRequestParser::queryParam(query, "flag", &found));
+    EXPECT_TRUE(found);
+    EXPECT_EQ("5", HttpRequestParser::queryParam(query, "limit"));
+    EXPECT_EQ("", HttpRequestParser::queryParam(query, "lim", &found));
+    EXPECT_FALSE(found);
+    EXPECT_EQ("100%", HttpRequestParser::urlDecode("100%"));
+    EXPECT_EQ("%zz", HttpRequestParser::urlDecode("%zz"));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
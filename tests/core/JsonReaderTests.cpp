@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include "JsonReader.h"
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+TEST(JsonReaderTest, WalksNestedValues) {
+    JsonReader json(R"( {"a": 1, "list": ["x", true, false, null, {}, [], -2.5e3], "b": {"c": "d"}} )");
+    json.beginObject();
+    std::string_view key;
+    ASSERT_TRUE(json.nextMember(key));
+    EXPECT_EQ("a", key);
+    EXPECT_EQ(1, json.integer());
+    ASSERT_TRUE(json.nextMember(key));
+    EXPECT_EQ("list", key);
+    json.beginArray();
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ("x", json.string());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_TRUE(json.boolean());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_FALSE(json.boolean());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(JsonReader::Type::NULL_VALUE, json.peek());
+    EXPECT_TRUE(json.null());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(JsonReader::Type::OBJECT, json.peek());
+    json.skipValue();
+    ASSERT_TRUE(json.nextElement());
+    json.skipValue();
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(JsonReader::Type::NUMBER, json.peek());
+    json.skipValue();
+    EXPECT_FALSE(json.nextElement());
+    ASSERT_TRUE(json.nextMember(key));
+    EXPECT_EQ("b", key);
+    json.skipValue();
+    EXPECT_FALSE(json.nextMember(key));
+    json.end();
+}
+
+TEST(JsonReaderTest, ReturnsViewsUnlessUnescaping) {
+    std::string text = R"(["plain caf\u00e9", "plain", "tab\there \"q\" \\ \/ \ud83d\ude00"])";
+    JsonReader json(text);
+    json.beginArray();
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ("plain caf\xc3\xa9", json.string());
+    ASSERT_TRUE(json.nextElement());
+    std::string_view plain = json.string();
+    EXPECT_EQ("plain", plain);
+    // No escapes, so the view points into the input
+    EXPECT_GE(plain.data(), text.data());
+    EXPECT_LT(plain.data(), text.data() + text.size());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ("tab\there \"q\" \\ / \xf0\x9f\x98\x80", json.string());
+    EXPECT_FALSE(json.nextElement());
+    json.end();
+}
+
+TEST(JsonReaderTest, KeysSurviveTheirValues) {
+    JsonReader json(R"({"k\u0065y": "v\u0061lue"})");
+    json.beginObject();
+    std::string_view key;
+    ASSERT_TRUE(json.nextMember(key));
+    std::string_view value = json.string();
+    EXPECT_EQ("key", key);
+    EXPECT_EQ("value", value);
+}
+
+TEST(JsonReaderTest, ReadsIntegers) {
+    JsonReader json("[0, -42, 9223372036854775807, 9223372036854775808, 1.5]");
+    json.beginArray();
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(0, json.integer());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(-42, json.integer());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_EQ(std::numeric_limits<long long>::max(), json.integer());
+    ASSERT_TRUE(json.nextElement());
+    EXPECT_THROW(json.integer(), std::runtime_error);
+}
+
+TEST(JsonReaderTest, RejectsMalformedInput) {
+    const char* cases[] = {
+        "",
+        "{",
+        "{\"a\":1,}",
+        "{,}",
+        "{\"a\" 1}",
+        "{a:1}",
+        "[1 2]",
+        "[01]",
+        "[-]",
+        "[1.]",
+        "[1e]",
+        "[tru]",
+        "[nul]",
+        "[\"unterminated]",
+        "[\"bad \\x escape\"]",
+        "[\"\\u12\"]",
+        "[\"\\udc00\"]",
+        "[\"\\ud800 lone\"]",
+        "[\"raw\ncontrol\"]",
+        "{} trailing",
+    };
+    for (const char* text : cases) {
+        EXPECT_THROW({
+            JsonReader json(text);
+            json.skipValue();
+            json.end();
+        }, std::runtime_error) << text;
+    }
+}
+
+TEST(JsonReaderTest, LimitsNesting) {
+    std::string deep(JsonReader::MAX_DEPTH, '[');
+    deep += std::string(JsonReader::MAX_DEPTH, ']');
+    JsonReader ok(deep);
+    ok.skipValue();
+    ok.end();
+
+    std::string tooDeep(100000, '[');
+    JsonReader json(tooDeep);
+    EXPECT_THROW(json.skipValue(), std::runtime_error);
+}
+
+TEST(JsonReaderTest, ErrorsNameTheOffset) {
+    JsonReader json(R"({"a": tru})");
+    try {
+        json.skipValue();
+        FAIL() << "Expected an exception";
+    } catch (const std::runtime_error& e) {
+        EXPECT_STREQ("Invalid JSON at offset 6: invalid literal", e.what());
+    }
+}
+
+TEST(JsonReaderTest, ReadsTasks) {
+    Task task{};
+    task.description = "stale";
+    task.dueDate = "stale";
+    JsonReader json(R"({ "id": 9, "difficulty" : 4, "extra": {"nested": [1, "}"]},
+                         "header": "Say \"hi\"", "completed": true, "description": null })");
+    ASSERT_TRUE(json.task(task));
+    json.end();
+    EXPECT_EQ("Say \"hi\"", task.header);
+    EXPECT_EQ(4, task.difficulty);
+    EXPECT_EQ("", task.description);
+    EXPECT_EQ("", task.dueDate);
+
+    JsonReader full(R"({"header":"h","description":"d","difficulty":1,"dueDate":"2024-06-15"})");
+    ASSERT_TRUE(full.task(task));
+    EXPECT_EQ("d", task.description);
+    EXPECT_EQ("2024-06-15", task.dueDate);
+
+    JsonReader missing(R"({"header":"h"})");
+    EXPECT_FALSE(missing.task(task));
+
+    JsonReader huge(R"({"header":"h","difficulty":4294967297})");
+    ASSERT_TRUE(huge.task(task));
+    EXPECT_EQ(0, task.difficulty);
+
+    JsonReader wrongType(R"({"header":"h","difficulty":"3"})");
+    EXPECT_THROW(wrongType.task(task), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
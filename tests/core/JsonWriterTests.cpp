@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+#include "JsonWriter.h"
+#include <limits>
+
+TEST(JsonWriterTest, TracksSeparatorsAcrossNesting) {
+    std::string out;
+    JsonWriter json(out);
+    json.beginObject()
+        .key("a").value(1)
+        .key("list").beginArray().value("x").value(true).beginObject().endObject().beginArray().endArray().endArray()
+        .key("b").value(false)
+        .key("c").null()
+        .endObject();
+    EXPECT_EQ(R"({"a":1,"list":["x",true,{},[]],"b":false,"c":null})", out);
+}
+
+TEST(JsonWriterTest, EscapesLikeTheServers) {
+    std::string out;
+    JsonWriter json(out);
+    json.value("q\"b\\n\n\x01 caf\xc3\xa9");
+    EXPECT_EQ("\"q\\u0022b\\u005cn\\u000a\\u0001 caf\xc3\xa9\"", out);
+    
+    std::string nul;
+    JsonWriter::appendEscaped(nul, std::string_view("a\0b", 3));
+    EXPECT_EQ("a\\u0000b", nul);
+}
+
+TEST(JsonWriterTest, FormatsIntegers) {
+    std::string out;
+    JsonWriter json(out);
+    json.beginArray().value(0).value(-42).value(std::numeric_limits<long long>::min())
+        .value(std::numeric_limits<unsigned long long>::max()).endArray();
+    EXPECT_EQ("[0,-42,-9223372036854775808,18446744073709551615]", out);
+}
+
+TEST(JsonWriterTest, FormatsDoubles) {
+    std::string out;
+    JsonWriter json(out);
+    json.beginArray().value(1.0).value(0.5).value(-2.25).value(0.1)
+        .value(std::numeric_limits<double>::quiet_NaN()).value(std::numeric_limits<double>::infinity()).endArray();
+    EXPECT_EQ("[1,0.5,-2.25,0.1,null,null]", out);
+}
+
+TEST(JsonWriterTest, WritesTasksInApiShape) {
+    Task task = {7, "Write \"docs\"", "", true, 3, "2024-05-01"};
+    std::string out;
+    JsonWriter json(out);
+    json.beginObject().key("tasks").beginArray().task(task).task(task).endArray().endObject();
+    std::string one = R"({"id":7,"header":"Write \u0022docs\u0022","description":"","completed":true,"difficulty":3,"dueDate":"2024-05-01"})";
+    EXPECT_EQ("{\"tasks\":[" + one + "," + one + "]}", out);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
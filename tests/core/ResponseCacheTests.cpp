@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+#include "ResponseCache.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(ResponseCacheTest, HitsOnlyForTheSameVersionAndVariant) {
+    ResponseCache cache(2);
+    EXPECT_EQ(nullptr, cache.get(0, 1, "a"));
+    
+    auto stored = cache.put(0, 1, "a", "body");
+    ASSERT_NE(nullptr, stored);
+    auto hit = cache.get(0, 1, "a");
+    ASSERT_NE(nullptr, hit);
+    EXPECT_EQ("body", *hit);
+    EXPECT_EQ(stored.get(), hit.get());
+    
+    EXPECT_EQ(nullptr, cache.get(0, 2, "a"));
+    EXPECT_EQ(nullptr, cache.get(0, 1, "b"));
+    EXPECT_EQ(nullptr, cache.get(1, 1, "a"));
+    
+    cache.clear();
+    EXPECT_EQ(nullptr, cache.get(0, 1, "a"));
+    EXPECT_EQ("body", *hit);  // Readers keep their bytes alive
+}
+
+TEST(ResponseCacheTest, KeepsTheNewestVersion) {
+    ResponseCache cache(1);
+    cache.put(0, 5, "", "new");
+    auto late = cache.put(0, 4, "", "old");  // A slow builder from before the last write
+    EXPECT_EQ("old", *late);
+    EXPECT_EQ("new", *cache.get(0, 5, ""));
+    
+    cache.put(0, 6, "", "newer");
+    EXPECT_EQ(nullptr, cache.get(0, 5, ""));
+    EXPECT_EQ("newer", *cache.get(0, 6, ""));
+}
+
+TEST(ResponseCacheTest, BuildsOnMissAndSharesAcrossThreads) {
+    ResponseCache cache(1);
+    std::atomic<int> builds{0};
+    std::atomic<bool> mismatch{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &builds, &mismatch] {
+            for (std::uint64_t version = 1; version <= 200; ++version) {
+                auto bytes = cache.getOrBuild(0, version / 10, "v", [&builds, version] {
+                    ++builds;
+                    return std::to_string(version / 10);
+                });
+                if (*bytes != std::to_string(version / 10)) {
+                    mismatch = true;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_FALSE(mismatch);
+    EXPECT_LT(builds, 4 * 200);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
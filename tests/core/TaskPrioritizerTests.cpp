@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include "TaskPrioritizer.h"
+#include "DueDate.h"
+#include <cmath>
+
+// Builds a task due `daysFromToday` days from now (NO_DUE_DAY for none)
+static Task makeTask(int id, int difficulty, int daysFromToday) {
+    Task task = {};
+    task.id = id;
+    task.header = "Task " + std::to_string(id);
+    task.difficulty = difficulty;
+    task.dueDay = daysFromToday == NO_DUE_DAY ? NO_DUE_DAY : currentEpochDay() + daysFromToday;
+    return task;
+}
+
+static std::vector<int> idsOf(const std::vector<Task>& tasks) {
+    std::vector<int> ids;
+    for (const auto& task : tasks) {
+        ids.push_back(task.id);
+    }
+    return ids;
+}
+
+TEST(TaskPrioritizerTest, DueDateFirstOrdersByDateThenHarderFirst) {
+    std::vector<Task> tasks = {
+        makeTask(1, 2, 5),
+        makeTask(2, 1, NO_DUE_DAY),
+        makeTask(3, 1, 1),
+        makeTask(4, 4, 1),
+    };
+    TaskPrioritizer prioritizer(TaskPrioritizer::Strategy::DUE_DATE_FIRST);
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{4, 3, 1, 2}));
+}
+
+TEST(TaskPrioritizerTest, DifficultyFirstOrdersEasierThenEarlier) {
+    std::vector<Task> tasks = {
+        makeTask(1, 3, 1),
+        makeTask(2, 1, 9),
+        makeTask(3, 1, 2),
+    };
+    TaskPrioritizer prioritizer(TaskPrioritizer::Strategy::DIFFICULTY_FIRST);
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{3, 2, 1}));
+}
+
+TEST(TaskPrioritizerTest, BalancedWeighsDaysByDifficulty) {
+    std::vector<Task> tasks = {
+        makeTask(1, 1, 4),           // score 4
+        makeTask(2, 5, 10),          // score 2
+        makeTask(3, 2, -3),          // past due, score 0
+        makeTask(4, 5, NO_DUE_DAY),  // no date, last
+    };
+    TaskPrioritizer prioritizer;
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{3, 2, 1, 4}));
+}
+
+TEST(TaskPrioritizerTest, WeightedCombinesDaysAndDifficulty) {
+    std::vector<Task> tasks = {
+        makeTask(1, 1, 4),           // 2*4 - 1 = 7
+        makeTask(2, 5, 6),           // 2*6 - 5 = 7, tie keeps input order
+        makeTask(3, 3, -2),          // past due: 0 - 3 = -3
+        makeTask(4, 5, NO_DUE_DAY),  // no date, last
+        makeTask(5, 2, 1),           // 2*1 - 2 = 0
+    };
+    TaskPrioritizer prioritizer(TaskPrioritizer::Weights{2.0, 1.0});
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{3, 5, 1, 2, 4}));
+}
+
+TEST(TaskPrioritizerTest, RejectsInvalidWeights) {
+    TaskPrioritizer prioritizer;
+    EXPECT_THROW(prioritizer.setWeights({-1.0, 1.0}), std::runtime_error);
+    EXPECT_THROW(prioritizer.setWeights({1.0, std::nan("")}), std::runtime_error);
+    EXPECT_NO_THROW(prioritizer.setWeights({0.0, 3.5}));
+    EXPECT_EQ(3.5, prioritizer.getWeights().difficulty);
+}
+
+TEST(TaskPrioritizerTest, StrategyNamesRoundTrip) {
+    for (auto strategy : TaskPrioritizer::allStrategies()) {
+        EXPECT_EQ(strategy, TaskPrioritizer::strategyFromName(TaskPrioritizer::strategyName(strategy)));
+    }
+    EXPECT_FALSE(TaskPrioritizer::strategyFromName("fastest"));
+}
+
+TEST(TaskPrioritizerTest, BuildsFromRequestParameters) {
+    EXPECT_EQ(TaskPrioritizer::Strategy::BALANCED, TaskPrioritizer::fromParameters("", "", "").getStrategy());
+    EXPECT_EQ(TaskPrioritizer::Strategy::DUE_DATE_FIRST,
+              TaskPrioritizer::fromParameters("due_date_first", "", "").getStrategy());
+    
+    TaskPrioritizer weighted = TaskPrioritizer::fromParameters("weighted", "0.5", "");
+    EXPECT_EQ(TaskPrioritizer::Strategy::WEIGHTED, weighted.getStrategy());
+    EXPECT_EQ(0.5, weighted.getWeights().dueDate);
+    EXPECT_EQ(TaskPrioritizer::Weights{}.difficulty, weighted.getWeights().difficulty);
+    
+    EXPECT_THROW(TaskPrioritizer::fromParameters("fastest", "", ""), std::invalid_argument);
+    EXPECT_THROW(TaskPrioritizer::fromParameters("balanced", "2", ""), std::invalid_argument);
+    EXPECT_THROW(TaskPrioritizer::fromParameters("weighted", "2x", ""), std::invalid_argument);
+    EXPECT_THROW(TaskPrioritizer::fromParameters("weighted", "", "-1"), std::invalid_argument);
+    EXPECT_THROW(TaskPrioritizer::fromParameters("weighted", "nan", ""), std::invalid_argument);
+}
+
+TEST(TaskPrioritizerTest, TiesKeepInputOrder) {
+    std::vector<Task> tasks = {
+        makeTask(7, 2, 4),
+        makeTask(3, 1, 2),
+        makeTask(5, 2, 4),
+    };
+    TaskPrioritizer prioritizer;
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{7, 3, 5}));
+}
+
+TEST(TaskPrioritizerTest, ParsesDueDateWhenDayIsUnset) {
+    std::vector<Task> tasks = {
+        {1, "Later", "", false, 1, "2030-01-02"},
+        {2, "Sooner", "", false, 1, "2030-01-01"},
+    };
+    TaskPrioritizer prioritizer(TaskPrioritizer::Strategy::DUE_DATE_FIRST);
+    prioritizer.prioritizeTasks(tasks);
+    EXPECT_EQ(idsOf(tasks), (std::vector<int>{2, 1}));
+}
+
+TEST(TaskPrioritizerTest, TopKMatchesPrefixOfFullOrder) {
+    std::vector<Task> tasks;
+    for (int i = 0; i < 50; ++i) {
+        tasks.push_back(makeTask(i, (i % 5) + 1, (i * 7) % 13 - 3));
+    }
+    tasks.push_back(makeTask(50, 3, NO_DUE_DAY));
+    
+    for (auto strategy : {TaskPrioritizer::Strategy::DUE_DATE_FIRST,
+                          TaskPrioritizer::Strategy::DIFFICULTY_FIRST,
+                          TaskPrioritizer::Strategy::BALANCED}) {
+        TaskPrioritizer prioritizer(strategy);
+        std::vector<Task> full = tasks;
+        prioritizer.prioritizeTasks(full);
+        
+        std::vector<Task> top = tasks;
+        prioritizer.prioritizeTopK(top, 10);
+        ASSERT_EQ(10, top.size());
+        for (size_t i = 0; i < top.size(); ++i) {
+            EXPECT_EQ(full[i].id, top[i].id);
+        }
+    }
+}
+
+TEST(TaskPrioritizerTest, ParallelMatchesSerialIncludingTies) {
+    // Few distinct dates and difficulties, so most keys tie
+    std::vector<Task> tasks;
+    for (int i = 0; i < 5003; ++i) {
+        tasks.push_back(makeTask(i, (i * 31) % 5 + 1, (i * 17) % 11 == 0 ? NO_DUE_DAY : (i * 13) % 9 - 2));
+    }
+    
+    for (auto strategy : {TaskPrioritizer::Strategy::DUE_DATE_FIRST,
+                          TaskPrioritizer::Strategy::DIFFICULTY_FIRST,
+                          TaskPrioritizer::Strategy::BALANCED}) {
+        std::vector<Task> serial = tasks;
+        TaskPrioritizer(strategy).prioritizeTasks(serial);
+        
+        for (unsigned threads : {2u, 3u, 8u}) {
+            std::vector<Task> parallel = tasks;
+            TaskPrioritizer prioritizer(strategy);
+            prioritizer.setParallelism(threads, 1);
+            prioritizer.prioritizeTasks(parallel);
+            EXPECT_EQ(idsOf(serial), idsOf(parallel));
+        }
+    }
+}
+
+TEST(TaskPrioritizerTest, BatchScoringMatchesScalarScore) {
+    // 37 entries so the vector kernel also runs its scalar tail
+    std::vector<std::int32_t> dueDays;
+    std::vector<std::int32_t> difficulties;
+    const int today = 20000;
+    for (int i = 0; i < 37; ++i) {
+        dueDays.push_back(i % 6 == 0 ? NO_DUE_DAY : today + (i * 11) % 40 - 10);
+        difficulties.push_back(i % 5 + 1);
+    }
+    
+    std::vector<float> scores(dueDays.size());
+    TaskPrioritizer::scoreBalanced({dueDays.data(), difficulties.data(), dueDays.size()}, today, scores.data());
+    for (size_t i = 0; i < scores.size(); ++i) {
+        EXPECT_EQ(TaskPrioritizer::balancedScore(dueDays[i], difficulties[i], today), scores[i]) << "at " << i;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -50,6 +50,21 @@ TEST(TaskTest, FieldModification) {
     EXPECT_EQ(task.dueDate, "2024-06-30");
 }
 
+// Due date conversion tests
+TEST(DueDateTest, ParsesIsoDatesToEpochDays) {
+    EXPECT_EQ(epochDayFromDate("1970-01-01"), 0);
+    EXPECT_EQ(epochDayFromDate("1969-12-31"), -1);
+    EXPECT_EQ(epochDayFromDate("2024-03-01") - epochDayFromDate("2024-02-28"), 2);  // Leap year
+    EXPECT_EQ(epochDayFromDate("2023-02-30"), epochDayFromDate("2023-03-02"));   // Rolls over like mktime
+}
+
+TEST(DueDateTest, RejectsMissingOrMalformedDates) {
+    EXPECT_EQ(epochDayFromDate(""), NO_DUE_DAY);
+    EXPECT_EQ(epochDayFromDate("2023-1-5"), NO_DUE_DAY);
+    EXPECT_EQ(epochDayFromDate("2023-13-01"), NO_DUE_DAY);
+    EXPECT_EQ(epochDayFromDate("abcd-ef-gh"), NO_DUE_DAY);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -1,5 +1,5 @@
 import React, { useState } from 'react';
-import { createTask } from '../services/taskService';
+import { createTask, suggestHeaders } from '../services/taskService';
 
 const TaskForm = ({ onTaskAdded }) => {
   const [task, setTask] = useState({
@@ -11,6 +11,7 @@ const TaskForm = ({ onTaskAdded }) => {
 
   const [error, setError] = useState('');
   const [submitting, setSubmitting] = useState(false);
+  const [suggestions, setSuggestions] = useState([]);
 
   const handleChange = (e) => {
     const { name, value } = e.target;
@@ -18,6 +19,17 @@ const TaskForm = ({ onTaskAdded }) => {
       ...task,
       [name]: name === 'difficulty' ? parseInt(value, 10) : value
     });
+
+    // Type-ahead of existing task titles
+    if (name === 'header') {
+      if (value.trim()) {
+        suggestHeaders(value)
+          .then(setSuggestions)
+          .catch(() => setSuggestions([]));
+      } else {
+        setSuggestions([]);
+      }
+    }
   };
 
   const handleSubmit = async (e) => {
@@ -119,6 +131,8 @@ const TaskForm = ({ onTaskAdded }) => {
             name="header"
             value={task.header}
             onChange={handleChange}
+            list="header-suggestions"
+            autoComplete="off"
             style={{
               width: '100%',
               padding: '10px',
@@ -129,6 +143,11 @@ const TaskForm = ({ onTaskAdded }) => {
               borderRadius: '4px'
             }}
           />
+          <datalist id="header-suggestions">
+            {suggestions.map((suggestion) => (
+              <option key={suggestion.header} value={suggestion.header} />
+            ))}
+          </datalist>
         </div>
 
         <div style={{ marginBottom: '15px' }}>
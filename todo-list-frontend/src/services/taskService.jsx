@@ -108,6 +108,16 @@ export const uncompleteTask = async (id) => {
   }
 };
 
+export const suggestHeaders = async (prefix) => {
+  try {
+    const response = await axios.get(`${API_URL}/tasks/suggest`, { params: { prefix, limit: 8 } });
+    return response.data.suggestions;
+  } catch (error) {
+    console.error('Error in suggestHeaders:', error);
+    throw error;
+  }
+};
+
 export const getPrioritizedTasks = async () => {
   try {
     const response = await axios.get(`${API_URL}/tasks/prioritized`);